@@ -9,7 +9,14 @@
     "-Wall", "-Wextra", "-O3", "-Wunused-function", "-std=c2x", "-m64", "-static"
 #define CINCLUDE "-IC:/Users/Couga/MingW_Dev_Lib/include"
 #define LINKLIB "-LC:/Users/Couga/MingW_Dev_Lib/lib"
-#define LINKFLAGS "-O3", "-s", "-m64", "-lraylibdll"
+#define LINKFLAGS "-O3", "-s", "-m64", "-lraylibdll", "-lpthread"
+// 素材熱重載 (Linux)：在 CFLAGS 加上 "-DHOT_RELOAD"
+// 配置追蹤 (glibc)：在 CFLAGS 加上 "-DALLOC_TRACK"
+// 定點數模擬 (跨建置逐位元相同)：在 CFLAGS 加上 "-DFIXED_POINT"，改用 Q24.8 再加上 "-DFIXED_FRAC_BITS=8"
+//   跨建置比對：各建置執行 "-realbench 6000 -hashlog <檔案>"，再以 "-hashdiff <a> <b>" 比對 (float 與定點的耗時也由同一命令輸出)
+#define PATHGEN_SRC "tools/pathgen.c" // 敵人路徑表產生器 (新增路徑時修改其參數表)
+#define PATHGEN_EXE "./" BUILD_FOLDER "/pathgen"
+#define PATHTABLE "src/pathtable.h" // 產生的路徑表 (所有目的檔都依賴它)
 
 static const char* src_files[] = {
     "main",
@@ -21,7 +28,45 @@ static const char* src_files[] = {
     "explod",
     "enemy",
     "rmath",
+    "hotreload",
+    "event",
+    "arena",
+    "alloctrack",
+    "snapshot",
+    "rewind",
+    "statehash",
+    "real",
+    "world",
+    "batch",
+    "env",
+    "autopilot",
+    "wave",
+    "script",
+    "spritemask",
+    "raycast",
+    "projectile",
+    "multiball",
+    "sweep",
+    "nearest",
+    "render",
+    "bench",
 };
+// 產生器原始碼比路徑表新時，編譯並執行產生器 (在主機上執行，不使用遊戲的 CFLAGS)
+bool GeneratePathTable(Cmd* cmd)
+{
+    int rebuild = nob_needs_rebuild1(PATHTABLE, PATHGEN_SRC);
+    if (rebuild <= 0) {
+        return rebuild == 0;
+    }
+    cmd->count = 0;
+    cmd_append(cmd, "gcc", "-O2", "-std=c2x", "-o", PATHGEN_EXE, PATHGEN_SRC, "-lm");
+    if (!cmd_run_sync_and_reset(cmd)) {
+        return false;
+    }
+    cmd_append(cmd, PATHGEN_EXE, PATHTABLE);
+    return cmd_run_sync_and_reset(cmd);
+}
+
 bool Build()
 {
     bool result = true;
@@ -32,11 +77,15 @@ bool Build()
     if (!mkdir_if_not_exists(BUILD_FOLDER)) {
         return_defer(false);
     }
+    if (!GeneratePathTable(&cmd)) {
+        return_defer(false);
+    }
     for (size_t i = 0; i < NOB_ARRAY_LEN(src_files); ++i) {
         const char* input_path = nob_temp_sprintf("src/%s.c", src_files[i]);
         const char* output_path = nob_temp_sprintf("./%s/%s.o", BUILD_FOLDER, src_files[i]);
+        const char* inputs[] = { input_path, PATHTABLE };
         nob_da_append(&object_files, output_path);
-        if (nob_needs_rebuild(output_path, &input_path, 1)) {
+        if (nob_needs_rebuild(output_path, inputs, NOB_ARRAY_LEN(inputs))) {
             cmd.count = 0;
             cmd_append(&cmd, "gcc", CFLAGS, CINCLUDE);
             cmd_append(&cmd, "-c", input_path);
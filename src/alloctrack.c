@@ -0,0 +1,169 @@
+#include "alloctrack.h"
+#include <stdlib.h>
+
+#if defined(ALLOC_TRACK) && defined(__GLIBC__)
+
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+
+// glibc 的原始配置函數
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t n, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+// 一個受追蹤執行緒的狀態 (每個執行緒有自己的幀內區間與統計)
+typedef struct {
+    AllocFrameStats cur; // 目前幀的統計
+    AllocFrameStats last; // 上一個完整幀的統計
+    bool enabled; // 是否追蹤本執行緒
+    bool inFrame; // 是否在幀內區間 (主執行緒：GameUpdate 到 EndDrawing；模擬執行緒：一個 tick)
+} AllocTrack;
+
+static _Thread_local AllocTrack track = { 0 };
+static _Thread_local bool inHook = false; // 避免 printf 等在掛鉤內再次配置造成遞迴
+static bool trackGuard = false; // 暖機後幀內配置是否中止程式 (AllocTrackInit 設定，所有受追蹤執行緒共用)
+static atomic_uint steadyAllocs = 0; // 所有受追蹤執行緒暖機後的幀內配置次數
+
+// 記錄一次配置
+static void Record(size_t size, void* site)
+{
+    if (!track.enabled || inHook) {
+        return;
+    }
+    inHook = true;
+    AllocFrameStats* f = &track.cur;
+    f->allocs++;
+    f->bytes += size;
+    int i = 0;
+    while (i < f->siteCount && f->sites[i].site != site) {
+        i++;
+    }
+    if (i < ALLOC_MAX_SITES) {
+        if (i == f->siteCount) {
+            f->sites[f->siteCount++] = (AllocSite) { site, 0, 0 };
+        }
+        f->sites[i].count++;
+        f->sites[i].bytes += size;
+    }
+    if (track.inFrame && f->frame > ALLOC_WARMUP_FRAMES) {
+        atomic_fetch_add_explicit(&steadyAllocs, 1u, memory_order_relaxed);
+    }
+    if (trackGuard && track.inFrame && f->frame > ALLOC_WARMUP_FRAMES) {
+        fprintf(stderr, "AllocTrack: %zu byte allocation at %p during frame %u\n", size, site, f->frame);
+        abort();
+    }
+    inHook = false;
+}
+
+void* malloc(size_t size)
+{
+    Record(size, __builtin_return_address(0));
+    return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size)
+{
+    Record(n * size, __builtin_return_address(0));
+    return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+    Record(size, __builtin_return_address(0));
+    return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr)
+{
+    if (ptr != NULL && track.enabled && !inHook) {
+        track.cur.frees++;
+    }
+    __libc_free(ptr);
+}
+
+/**
+ * @brief 開始追蹤 (在主執行緒上、啟動其他受追蹤的執行緒之前呼叫一次)，並追蹤目前執行緒
+ */
+void AllocTrackInit(bool guard)
+{
+    trackGuard = guard;
+    atomic_store(&steadyAllocs, 0u);
+    AllocTrackThread();
+}
+
+/**
+ * @brief 追蹤目前執行緒 (幀編號從 0 開始，同樣先經過暖機)
+ */
+void AllocTrackThread()
+{
+    memset(&track, 0, sizeof(track));
+    track.enabled = true;
+}
+
+/**
+ * @brief 幀內區間開始
+ */
+void AllocTrackFrameBegin()
+{
+    track.inFrame = true;
+}
+
+/**
+ * @brief 幀內區間結束，輸出本幀摘要到 metrics 輸出 (stdout)
+ */
+void AllocTrackFrameEnd()
+{
+    track.inFrame = false;
+    inHook = true;
+    AllocFrameStats* f = &track.cur;
+    if (f->allocs > 0 && f->frame > ALLOC_WARMUP_FRAMES) {
+        printf("[metrics] alloc frame=%u allocs=%u frees=%u bytes=%zu", f->frame, f->allocs, f->frees, f->bytes);
+        for (int i = 0; i < f->siteCount; i++) {
+            printf(" site=%p:%u:%zu", f->sites[i].site, f->sites[i].count, f->sites[i].bytes);
+        }
+        printf("\n");
+    }
+    inHook = false;
+    track.last = *f;
+    uint32_t next = f->frame + 1;
+    memset(f, 0, sizeof(*f));
+    f->frame = next;
+}
+
+/**
+ * @brief 目前執行緒上一個完整幀的統計資料
+ */
+AllocFrameStats AllocTrackLastFrame()
+{
+    return track.last;
+}
+
+/**
+ * @brief 所有受追蹤執行緒自 AllocTrackInit 以來暖機後的幀內配置次數
+ */
+uint32_t AllocTrackSteadyAllocs()
+{
+    return atomic_load_explicit(&steadyAllocs, memory_order_relaxed);
+}
+
+#else
+
+void AllocTrackInit(bool guard)
+{
+    (void)guard;
+}
+void AllocTrackThread() { }
+void AllocTrackFrameBegin() { }
+void AllocTrackFrameEnd() { }
+AllocFrameStats AllocTrackLastFrame()
+{
+    return (AllocFrameStats) { 0 };
+}
+uint32_t AllocTrackSteadyAllocs()
+{
+    return 0;
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef __ALLOCTRACK_H__
+#define __ALLOCTRACK_H__
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 配置追蹤 (僅在以 -DALLOC_TRACK 編譯且使用 glibc 時啟用，否則以下函數皆為空操作)
+// 以覆寫 malloc/calloc/realloc/free 的方式攔截所有配置。raylib 的 MemAlloc/MemFree
+// 預設經由 RL_MALLOC/RL_FREE 呼叫 libc，因此 raylib 內部的配置也會被計入。
+// 只統計呼叫 AllocTrackInit() 的執行緒 (遊戲主執行緒) 與呼叫 AllocTrackThread() 的執行緒 (管線模式的模擬執行緒)，
+// 其他背景執行緒 (例如素材解碼) 的配置不計入。每個受追蹤的執行緒各自標記幀內區間、各自暖機與統計。
+
+#define ALLOC_MAX_SITES 16 // 每幀記錄的呼叫位置數量
+#define ALLOC_WARMUP_FRAMES 120 // 暖機幀數 (載入與快取填充期間允許配置)
+
+typedef struct AllocSite {
+    void* site; // 呼叫 malloc 的返回位址 (以 addr2line 對照原始碼)
+    uint32_t count; // 本幀於此位置的配置次數
+    size_t bytes; // 本幀於此位置配置的位元組數
+} AllocSite;
+
+typedef struct AllocFrameStats {
+    uint32_t frame; // 幀編號
+    uint32_t allocs; // 本幀配置次數
+    uint32_t frees; // 本幀釋放次數
+    size_t bytes; // 本幀配置的位元組數
+    int siteCount;
+    AllocSite sites[ALLOC_MAX_SITES];
+} AllocFrameStats;
+
+void AllocTrackInit(bool guard); // 開始追蹤目前執行緒，guard 為 true 時暖機後任何受追蹤執行緒的幀內配置都會中止程式
+void AllocTrackThread(); // 追蹤目前執行緒 (AllocTrackInit 之後，在該執行緒開頭呼叫)
+void AllocTrackFrameBegin(); // 目前執行緒的幀內區間開始 (GameUpdate 開頭；模擬執行緒為 tick 開頭)
+void AllocTrackFrameEnd(); // 目前執行緒的幀內區間結束 (EndDrawing 之後；模擬執行緒為發佈畫面之後)，輸出本幀摘要
+AllocFrameStats AllocTrackLastFrame(); // 目前執行緒上一個完整幀的統計資料
+uint32_t AllocTrackSteadyAllocs(); // 所有受追蹤執行緒暖機後的幀內配置次數 (穩定狀態下不增加)
+
+#endif
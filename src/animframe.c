@@ -1,5 +1,91 @@
 #include "animframe.h"
 #include <stdio.h>
+#include <string.h>
+
+#define MAX_TEX_CACHE 32 // 快取可容納的紋理數量
+#define TEX_NAME_LEN 128 // 快取鍵 (檔名) 的最大長度
+#define MAX_TRACKED 32 // 可登記熱重載的 AnimFrame 數量
+
+// 紋理快取項目 (以檔名為鍵)
+typedef struct {
+    char name[TEX_NAME_LEN]; // 紋理檔名
+    Texture2D tex; // 已上傳的紋理
+    int refCount; // 引用計數 (0 表示此欄位未使用)
+} TexCacheEntry;
+
+typedef struct {
+    TexCacheEntry entry[MAX_TEX_CACHE];
+    AnimFrameCacheStats stats;
+    AnimFrame* tracked[MAX_TRACKED]; // 紋理替換時需要同步更新的 AnimFrame
+    int trackedCount;
+} TexCache;
+
+static TexCache texCache = { 0 };
+
+// 估算紋理佔用的位元組數
+static size_t TexBytes(Texture2D tex)
+{
+    return (size_t)GetPixelDataSize(tex.width, tex.height, tex.format);
+}
+
+// 以檔名尋找快取項目，找不到時返回 NULL
+static TexCacheEntry* TexCacheFind(const char* fname)
+{
+    for (int i = 0; i < MAX_TEX_CACHE; i++) {
+        TexCacheEntry* e = &texCache.entry[i];
+        if (e->refCount > 0 && strcmp(e->name, fname) == 0) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+// 以紋理 ID 尋找快取項目，找不到時返回 NULL
+static TexCacheEntry* TexCacheFindId(unsigned int id)
+{
+    for (int i = 0; i < MAX_TEX_CACHE; i++) {
+        TexCacheEntry* e = &texCache.entry[i];
+        if (e->refCount > 0 && e->tex.id == id) {
+            return e;
+        }
+    }
+    return NULL;
+}
+
+// 取得 (或載入) 指定檔名的紋理，並增加引用計數
+static Texture2D TexCacheAcquire(const char* fname)
+{
+    TexCacheEntry* e = TexCacheFind(fname);
+    if (e != NULL) {
+        e->refCount++;
+        texCache.stats.hits++;
+        return e->tex;
+    }
+    texCache.stats.misses++;
+    Texture2D tex = LoadTexture(fname); // 使用 Raylib 加載紋理
+    if (tex.id == 0) {
+        return tex;
+    }
+    if (strlen(fname) >= TEX_NAME_LEN) {
+        // 檔名過長無法作為鍵，不進快取 (呼叫者仍可正常使用，卸載時直接釋放)
+        printf("Warning: Texture name too long to cache: %s\n", fname);
+        return tex;
+    }
+    for (int i = 0; i < MAX_TEX_CACHE; i++) {
+        e = &texCache.entry[i];
+        if (e->refCount == 0) {
+            strcpy(e->name, fname);
+            e->tex = tex;
+            e->refCount = 1;
+            texCache.stats.entries++;
+            texCache.stats.residentBytes += TexBytes(tex);
+            return tex;
+        }
+    }
+    printf("Warning: Texture cache is full, %s is not cached\n", fname);
+    return tex;
+}
+
 /**
  * @brief 從文件加載紋理並創建 AnimFrame
  */
@@ -7,7 +93,7 @@ AnimFrame AnimFrameLoad(const char* fname, uint16_t cell_width, uint16_t cell_he
 {
     AnimFrame a = { 0 }; // 初始化結構體
 
-    a.tex = LoadTexture(fname); // 使用 Raylib 加載紋理
+    a.tex = TexCacheAcquire(fname); // 從快取取得紋理 (未命中時才真正載入)
     // 檢查紋理是否加載成功 (Raylib 中，失敗時 id 為 0)
     if (a.tex.id == 0) {
         printf("Error: Failed to load texture from %s\n", fname);
@@ -44,8 +130,85 @@ AnimFrame AnimFrameLoad(const char* fname, uint16_t cell_width, uint16_t cell_he
  */
 void AnimFrameUnload(AnimFrame* af)
 {
-    // 使用 Raylib 的函數卸載紋理，釋放 GPU 內存
-    UnloadTexture(af->tex);
-    // 可以選擇性地將 af->tex.id 設為 0，表示已卸載
+    if (af->tex.id == 0) {
+        return; // 未載入或已卸載
+    }
+    TexCacheEntry* e = TexCacheFindId(af->tex.id);
+    if (e == NULL) {
+        // 不在快取中的紋理，直接釋放 GPU 內存
+        UnloadTexture(af->tex);
+    } else if (--e->refCount == 0) {
+        // 最後一個引用者，釋放 GPU 內存並清出快取欄位
+        texCache.stats.entries--;
+        texCache.stats.residentBytes -= TexBytes(e->tex);
+        UnloadTexture(e->tex);
+        e->name[0] = '\0';
+        e->tex = (Texture2D) { 0 };
+    }
+    // 將 af->tex.id 設為 0，表示已卸載
     af->tex.id = 0;
 }
+/**
+ * @brief 取得紋理快取的統計資料
+ */
+AnimFrameCacheStats AnimFrameCacheGetStats(void)
+{
+    return texCache.stats;
+}
+/**
+ * @brief 登記一個常駐的 AnimFrame
+ */
+void AnimFrameTrack(AnimFrame* af)
+{
+    for (int i = 0; i < texCache.trackedCount; i++) {
+        if (texCache.tracked[i] == af) {
+            return; // 已登記 (例如 BallInit 重複呼叫)
+        }
+    }
+    if (texCache.trackedCount >= MAX_TRACKED) {
+        printf("Warning: Too many tracked AnimFrames, hot reload disabled for one frame set\n");
+        return;
+    }
+    texCache.tracked[texCache.trackedCount++] = af;
+}
+/**
+ * @brief 以新的影像替換快取中的紋理
+ */
+bool AnimFrameCacheReplace(const char* fname, Image img)
+{
+    TexCacheEntry* e = TexCacheFind(fname);
+    if (e == NULL || img.data == NULL) {
+        return false;
+    }
+    if (img.width == e->tex.width && img.height == e->tex.height && img.format == e->tex.format) {
+        // 尺寸與格式相同，紋理 ID 不變，所有 AnimFrame 副本仍然有效
+        UpdateTexture(e->tex, img.data);
+        return true;
+    }
+    Texture2D tex = LoadTextureFromImage(img);
+    if (tex.id == 0) {
+        printf("Error: Failed to upload reloaded texture %s\n", fname);
+        return false;
+    }
+    unsigned int oldId = e->tex.id;
+    texCache.stats.residentBytes -= TexBytes(e->tex);
+    texCache.stats.residentBytes += TexBytes(tex);
+    UnloadTexture(e->tex);
+    e->tex = tex;
+    // 更新所有引用舊紋理的 AnimFrame，並重新計算網格數量
+    for (int i = 0; i < texCache.trackedCount; i++) {
+        AnimFrame* af = texCache.tracked[i];
+        if (af->tex.id != oldId) {
+            continue;
+        }
+        af->tex = tex;
+        if (af->cellW > 0 && af->cellH > 0) {
+            af->xCellCount = tex.width / af->cellW;
+            af->yCellCount = tex.height / af->cellH;
+            // 新圖比單元格還小時至少保留一格，避免繪製時以 0 取餘數
+            if (af->xCellCount < 1) af->xCellCount = 1;
+            if (af->yCellCount < 1) af->yCellCount = 1;
+        }
+    }
+    return true;
+}
@@ -2,6 +2,7 @@
 #define __ANIMFRAME_H__
 
 #include "raylib.h"
+#include <stddef.h>
 #include <stdint.h>
 
 typedef struct AnimFrame {
@@ -13,8 +14,18 @@ typedef struct AnimFrame {
     int xCellCount; // 紋理在 X 軸方向上的網格單元數量
     int yCellCount; // 紋理在 Y 軸方向上的網格單元數量
 } AnimFrame;
+
+// 紋理快取統計資料
+typedef struct AnimFrameCacheStats {
+    uint32_t hits; // 快取命中次數 (重複載入同名紋理)
+    uint32_t misses; // 快取未命中次數 (實際呼叫 LoadTexture)
+    uint32_t entries; // 目前常駐的紋理數量
+    size_t residentBytes; // 目前常駐紋理佔用的 GPU 記憶體 (位元組)
+} AnimFrameCacheStats;
+
 /**
  * @brief 從文件加載紋理並創建 AnimFrame
+ * 同名紋理只會上傳一次，之後的呼叫直接取用快取並增加引用計數。
  * @param fname 紋理圖片文件的路徑
  * @param cell_width Sprite Sheet 中每個單元的寬度
  * @param cell_height Sprite Sheet 中每個單元的高度
@@ -24,8 +35,29 @@ AnimFrame AnimFrameLoad(const char* fname, uint16_t cell_width, uint16_t cell_he
 
 /**
  * @brief 卸載 AnimFrame 中的紋理資源
+ * 引用計數歸零時才真正釋放 GPU 紋理。
  * @param af 指向要卸載的 AnimFrame 的指標
  */
 void AnimFrameUnload(AnimFrame* af);
 
-#endif
\ No newline at end of file
+/**
+ * @brief 取得紋理快取的統計資料
+ */
+AnimFrameCacheStats AnimFrameCacheGetStats(void);
+
+/**
+ * @brief 登記一個常駐的 AnimFrame，紋理被熱重載替換時會同步更新它
+ * @param af 指向常駐 AnimFrame 的指標 (必須在整個遊戲期間有效)
+ */
+void AnimFrameTrack(AnimFrame* af);
+
+/**
+ * @brief 以新的影像替換快取中的紋理 (必須在繪圖執行緒、幀與幀之間呼叫)
+ * 尺寸不變時原地更新紋理內容，否則重新上傳並更新所有已登記的 AnimFrame。
+ * @param fname 紋理檔名 (快取鍵)
+ * @param img 新的影像資料 (呼叫者負責釋放)
+ * @return true 若該檔名在快取中且已替換
+ */
+bool AnimFrameCacheReplace(const char* fname, Image img);
+
+#endif
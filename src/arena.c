@@ -0,0 +1,74 @@
+#include "arena.h"
+#include "brickout.h"
+#include <stdio.h>
+#include <string.h>
+
+#define FRAME_ARENA_SIZE (256 * 1024) // 每個緩衝區的大小 (位元組)
+#define ARENA_POISON 0xDD // DEBUG 模式下重設時填入的位元組，便於發現使用已失效資料
+
+typedef struct {
+    _Alignas(64) uint8_t mem[2][FRAME_ARENA_SIZE];
+    size_t offset[2]; // 各緩衝區目前的配置位置
+    int current; // 目前配置中的緩衝區
+    FrameArenaStats stats;
+} FrameArena;
+
+static _Thread_local FrameArena arena = { 0 }; // 每個執行緒各自的暫存配置器 (批次執行時互不干擾)
+
+/**
+ * @brief 重設兩個緩衝區與統計資料
+ */
+void FrameArenaInit()
+{
+    arena.offset[0] = 0;
+    arena.offset[1] = 0;
+    arena.current = 0;
+    arena.stats = (FrameArenaStats) { .capacity = FRAME_ARENA_SIZE };
+}
+
+/**
+ * @brief 切換緩衝區
+ * 上一幀的緩衝區保留給繪圖使用，兩幀前的緩衝區被重設後成為新的配置來源。
+ */
+void FrameArenaSwap()
+{
+    arena.current ^= 1;
+#ifdef DEBUG
+    // 毒化被回收的記憶體，讀到 0xDD 表示持有了超過兩幀的指標
+    memset(arena.mem[arena.current], ARENA_POISON, arena.offset[arena.current]);
+#endif
+    arena.offset[arena.current] = 0;
+}
+
+/**
+ * @brief O(1) 線性配置
+ * @param size 位元組數
+ * @param align 對齊 (必須為 2 的冪次)
+ * @return 配置的記憶體，空間不足時返回 NULL (不會退回堆積配置)
+ */
+void* FrameAlloc(size_t size, size_t align)
+{
+    size_t offset = (arena.offset[arena.current] + (align - 1)) & ~(align - 1);
+    if (offset + size > FRAME_ARENA_SIZE) {
+        arena.stats.overflows++;
+#ifdef DEBUG
+        printf("Warning: Frame arena overflow (%zu bytes requested).\n", size);
+#endif
+        return NULL;
+    }
+    arena.offset[arena.current] = offset + size;
+    if (offset + size > arena.stats.highWater) {
+        arena.stats.highWater = offset + size;
+    }
+    return arena.mem[arena.current] + offset;
+}
+
+/**
+ * @brief 取得配置器統計資料
+ */
+FrameArenaStats FrameArenaGetStats()
+{
+    FrameArenaStats stats = arena.stats;
+    stats.used = arena.offset[arena.current];
+    return stats;
+}
@@ -0,0 +1,26 @@
+#ifndef __ARENA_H__
+#define __ARENA_H__
+#include <stddef.h>
+#include <stdint.h>
+
+// 每幀線性配置器 (雙緩衝)
+// 幀 N 配置的資料在幀 N+1 模擬期間仍然有效，到幀 N+2 開頭才被重設。
+// 記憶體來自靜態緩衝區，穩定狀態下不會產生任何堆積配置。
+// 緩衝區為執行緒區域儲存，每個執行緒各有一組 (批次執行器的工作執行緒各自使用)。
+
+typedef struct FrameArenaStats {
+    size_t capacity; // 每個緩衝區的容量 (位元組)
+    size_t used; // 目前緩衝區已使用的位元組數
+    size_t highWater; // 單幀使用量的歷史最高值
+    uint32_t overflows; // 因容量不足而失敗的配置次數
+} FrameArenaStats;
+
+void FrameArenaInit(); // 重設兩個緩衝區與統計資料
+void FrameArenaSwap(); // 幀開頭呼叫：切換緩衝區並重設新的目前緩衝區
+void* FrameAlloc(size_t size, size_t align); // O(1) 配置，空間不足時返回 NULL
+FrameArenaStats FrameArenaGetStats();
+
+// 配置 n 個 T 型別的元素
+#define FRAME_NEW(T, n) ((T*)FrameAlloc(sizeof(T) * (size_t)(n), _Alignof(T)))
+
+#endif
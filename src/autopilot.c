@@ -0,0 +1,139 @@
+#include "autopilot.h"
+#include "brickout.h"
+#include "statehash.h"
+#include "world.h"
+
+#define AUTOPILOT_MIN_DIR_Y R(0.1f) // 方向幾乎水平時不預測 (也避免定點數溢位)
+#define AUTOPILOT_DEADZONE R(5.0f) // 玩家板中心與目標的容許差距 (約半個 tick 的移動量，避免來回抖動)
+
+_Static_assert((AUTOPILOT_MAX_LATENCY & (AUTOPILOT_MAX_LATENCY - 1)) == 0, "AUTOPILOT_MAX_LATENCY must be a power of two");
+
+// 返回 [-1000, 1000] 範圍內的亂數
+static int AutopilotRandom(Autopilot* ap)
+{
+    uint32_t x = ap->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    ap->rng = x;
+    return (int)(x % 2001u) - 1000;
+}
+
+static Real PaddleCenterX()
+{
+    return gWorld->player.rect.x + gWorld->player.rect.width / 2;
+}
+
+/**
+ * @brief 在目前世界啟用自動駕駛
+ *
+ * @param config 瞄準誤差與反應延遲
+ * @param seed 瞄準誤差的亂數種子
+ */
+void AutopilotEnable(AutopilotConfig config, uint32_t seed)
+{
+    Autopilot* ap = &gWorld->autopilot;
+    if (config.latencyTicks < 0) {
+        config.latencyTicks = 0;
+    }
+    if (config.latencyTicks > AUTOPILOT_MAX_LATENCY - 1) {
+        config.latencyTicks = AUTOPILOT_MAX_LATENCY - 1;
+    }
+    ap->enabled = true;
+    ap->config = config;
+    ap->offset = 0;
+    ap->falling = false;
+    ap->rng = seed != 0 ? seed : 1u;
+    ap->head = 0;
+    Real center = PaddleCenterX(); // 延遲期間先停在原地
+    for (int i = 0; i < AUTOPILOT_MAX_LATENCY; i++) {
+        ap->predicted[i] = center;
+    }
+}
+
+void AutopilotDisable()
+{
+    gWorld->autopilot.enabled = false;
+    gWorld->input = (GameInput) { 0 };
+}
+
+bool AutopilotEnabled()
+{
+    return gWorld->autopilot.enabled;
+}
+
+/**
+ * @brief 球到達玩家板高度時的 x 座標
+ * 把左右牆之間的反射展開成週期 2L 的直線 (L 為球心可移動的寬度)，再折回 [0, L]。
+ * 球向上移動時先計算到上牆的距離，反射後再加上到玩家板的距離。敵人造成的反彈無法預測。
+ */
+Real AutopilotPredictLandingX()
+{
+    const Ball* ball = &gWorld->ball;
+    Real r = ball->radius;
+    Real landY = gWorld->player.rect.y - r; // 球心接觸玩家板時的 y
+    Real dirY = ball->acceleration.y;
+    if (dirY > -AUTOPILOT_MIN_DIR_Y && dirY < AUTOPILOT_MIN_DIR_Y) {
+        return ball->pos.x;
+    }
+    Real dy = dirY > 0 ? landY - ball->pos.y : (ball->pos.y - r) + (landY - r);
+    if (dy < 0) { // 已經低於玩家板
+        return ball->pos.x;
+    }
+    Real slope = RDiv(ball->acceleration.x, dirY > 0 ? dirY : -dirY); // 每前進 1 像素 y 的 x 位移
+    Real x = ball->pos.x + RMul(dy, slope);
+    Real width = R(SCR_WIDTH) - 2 * r;
+    Real u = RWrap(x - r, 2 * width);
+    if (u > width) {
+        u = 2 * width - u;
+    }
+    return r + u;
+}
+
+/**
+ * @brief 預測落點並寫入 gWorld->input
+ * 每次球開始下落時重新取樣瞄準誤差；移動目標使用 latencyTicks 之前的預測值。
+ */
+void AutopilotUpdate()
+{
+    Autopilot* ap = &gWorld->autopilot;
+    bool falling = gWorld->ball.acceleration.y > 0;
+    if (falling && !ap->falling) {
+        Real unit = RDiv(RFromFloat((float)AutopilotRandom(ap)), R(1000.0f)); // -1 到 1
+        ap->offset = RMul(RFromFloat(ap->config.errorPx), unit);
+    }
+    ap->falling = falling;
+
+    ap->predicted[ap->head % AUTOPILOT_MAX_LATENCY] = AutopilotPredictLandingX() + ap->offset;
+    ap->head++;
+    Real aim = ap->predicted[(ap->head - 1 - (uint32_t)ap->config.latencyTicks) % AUTOPILOT_MAX_LATENCY];
+
+    Real center = PaddleCenterX();
+    gWorld->input.left = center > aim + AUTOPILOT_DEADZONE;
+    gWorld->input.right = center < aim - AUTOPILOT_DEADZONE;
+    gWorld->input.fire = gWorld->player.laserTicks > 0; // 有雷射道具時持續發射
+}
+
+// 自動駕駛的狀態 (快照用)
+StateBlock AutopilotStateBlock()
+{
+    return (StateBlock) { &gWorld->autopilot, sizeof(Autopilot) };
+}
+
+// 將自動駕駛的狀態逐欄位累加進雜湊值 (不含填充位元組)；停用時其餘欄位不影響模擬，只累加啟用旗標
+uint64_t AutopilotStateHash(uint64_t h)
+{
+    const Autopilot* ap = &gWorld->autopilot;
+    h = StateHashBytes(h, &ap->enabled, sizeof(ap->enabled));
+    if (!ap->enabled) {
+        return h;
+    }
+    h = StateHashBytes(h, &ap->config.errorPx, sizeof(ap->config.errorPx));
+    h = StateHashBytes(h, &ap->config.latencyTicks, sizeof(ap->config.latencyTicks));
+    h = StateHashBytes(h, &ap->offset, sizeof(ap->offset));
+    h = StateHashBytes(h, &ap->falling, sizeof(ap->falling));
+    h = StateHashBytes(h, &ap->rng, sizeof(ap->rng));
+    h = StateHashBytes(h, &ap->head, sizeof(ap->head));
+    h = StateHashBytes(h, ap->predicted, sizeof(ap->predicted));
+    return h;
+}
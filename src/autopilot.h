@@ -0,0 +1,42 @@
+#ifndef __AUTOPILOT_H__
+#define __AUTOPILOT_H__
+#include "real.h"
+#include "snapshot.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// 自動駕駛玩家 (無人值守的長時間測試、效能量測)
+// 以球目前的方向射線在左右牆之間反射，解析計算球到達玩家板高度時的 x 座標，並把玩家板移過去。
+// 以瞄準誤差與反應延遲模擬人類，讓批次執行維持在有敵人、有擊中的穩定狀態，而不是一直重設。
+// 啟用時由 PlayerUpdate 呼叫，覆寫世界的輸入狀態；只使用 Real 運算，定點模式下仍是確定性的。
+
+#define AUTOPILOT_MAX_LATENCY 64 // 反應延遲上限 (tick)
+
+// 自動駕駛參數
+typedef struct AutopilotConfig {
+    float errorPx; // 瞄準誤差 (像素)，每次球開始下落時在 [-errorPx, errorPx] 內重新取樣
+    int latencyTicks; // 反應延遲 (tick)，使用此 tick 數之前的預測值
+} AutopilotConfig;
+
+#define AUTOPILOT_DEFAULT ((AutopilotConfig) { 8.0f, 6 }) // 約 100ms 反應時間
+
+// 自動駕駛狀態 (每個 GameWorld 各有一個，屬於快照：還原後以相同的亂數與延遲預測繼續)
+typedef struct Autopilot {
+    bool enabled;
+    AutopilotConfig config;
+    Real offset; // 目前的瞄準誤差
+    bool falling; // 上一個 tick 球是否向下移動
+    uint32_t rng; // xorshift32 亂數狀態 (不可為 0)
+    uint32_t head; // 預測值環形緩衝區的寫入位置
+    Real predicted[AUTOPILOT_MAX_LATENCY]; // 最近的預測落點 (延遲用)
+} Autopilot;
+
+void AutopilotEnable(AutopilotConfig config, uint32_t seed); // 在目前世界啟用自動駕駛
+void AutopilotDisable(); // 停用，恢復由鍵盤或外部控制器寫入輸入
+bool AutopilotEnabled();
+void AutopilotUpdate(); // 預測落點並寫入 gWorld->input
+Real AutopilotPredictLandingX(); // 球到達玩家板高度時的 x 座標 (只考慮牆壁反射)
+StateBlock AutopilotStateBlock(); // 自動駕駛的狀態 (快照用)
+uint64_t AutopilotStateHash(uint64_t h); // 將自動駕駛的狀態累加進雜湊值
+
+#endif
@@ -1,125 +1,154 @@
 #include "animframe.h"
+#include "ball.h"
 #include "brick.h"
 #include "brickout.h"
 #include "enemy.h"
-#include "explod.h"
+#include "event.h"
 #include "gfx.h"
 #include "player.h"
 #include "raylib.h"
+#include "real.h"
+#include "render.h"
+#include "spritemask.h"
+#include "statehash.h"
 #include "timer.h"
-#include <math.h>
+#include "world.h"
 
-// Ball structure
-typedef struct {
-    Vec2 pos; // 球的中心位置
-    Vec2 acceleration; // 球的加速度方向向量 (單位向量)
-    float velocity; // 球的速度 (純量)
-    float radius; // 球的半徑 (用於碰撞)
-    AnimFrame af;
-} Ball;
+static AnimFrame ballAf = { 0 }; // 球的貼圖 (不屬於模擬狀態，快照時不保存)
+static SpriteMask ballMask; // 球的碰撞遮罩 (所有世界共用)
 
-Ball ball = { 0 }; // 全域球物件
-
-// 初始化球的狀態
+// 載入球的貼圖 (所有世界共用)
 void BallInit()
 {
-    ball.af = AnimFrameLoad("asset/ball.png", 16, 16);
-    ball.pos = (Vec2) { SCR_WIDTH / 2.0f, SCR_HEIGHT / 2.0f + 100.0f }; // 球的初始中心位置
-    ball.radius = BALL_RADIUS; // 球的半徑
-    ball.acceleration = (Vec2) { 0.5f, 1.0f }; // 初始加速度方向 (非單位化，將在Update中被速度影響)
-                                               // 為了避免一開始就水平或垂直，給一些初始偏移
-    // 正規化加速度向量 (使其長度為1)，這樣速度才能精確控制移動幅度
-    float mag = sqrtf(ball.acceleration.x * ball.acceleration.x + ball.acceleration.y * ball.acceleration.y);
-    if (mag > 0) {
-        ball.acceleration.x /= mag;
-        ball.acceleration.y /= mag;
-    } else {
-        ball.acceleration = (Vec2) { 0.0f, 1.0f }; // 預設向下
+    // 先取得新的引用再釋放舊的，重複初始化時直接命中紋理快取，不會重新上傳
+    AnimFrame af = AnimFrameLoad("asset/ball.png", 16, 16);
+    AnimFrameUnload(&ballAf);
+    ballAf = af;
+    AnimFrameTrack(&ballAf); // 素材熱重載時同步更新
+}
+// 由球的貼圖產生碰撞遮罩 (所有世界共用，建立世界之前呼叫一次)，載入失敗時使用實心圓
+void BallMaskInit()
+{
+    if (!SpriteMaskLoad(&ballMask, "asset/ball.png", BALL_SIZE, BALL_SIZE)) {
+        SpriteMaskDisc(&ballMask, BALL_SIZE);
     }
-    ball.velocity = 350.0f; // 球的移動速度 (像素/秒)
+}
+// 初始化目前世界中球的狀態
+void BallReset()
+{
+    Ball* ball = &gWorld->ball;
+    ball->pos = (RVec2) { R(SCR_WIDTH / 2.0f), R(SCR_HEIGHT / 2.0f + 100.0f) }; // 球的初始中心位置
+    ball->radius = R(BALL_RADIUS); // 球的半徑
+    ball->acceleration = (RVec2) { R(0.5f), R(1.0f) }; // 初始加速度方向 (非單位化，將在Update中被速度影響)
+                                                      // 為了避免一開始就水平或垂直，給一些初始偏移
+    // 正規化加速度向量 (使其長度為1)，這樣速度才能精確控制移動幅度
+    ball->acceleration = RVec2Normalize(ball->acceleration);
+    ball->velocity = R(350.0f); // 球的移動速度 (像素/秒)
 }
 void BallFini()
 {
-    AnimFrameUnload(&ball.af);
+    AnimFrameUnload(&ballAf);
 }
-// 更新球的邏輯
-void BallUpdate()
+/**
+ * @brief 移動一顆球並處理與敵人、牆壁、玩家板的碰撞 (主球與多球模式的額外球共用)
+ * 反彈在此立即處理，得分、爆炸、移除敵人等反應寫入事件佇列，於幀尾批次處理
+ *
+ * @return true 若球掉出畫面底部 (由呼叫端決定後果)
+ */
+bool BallMove(RVec2* pos, RVec2* dir, Real speed, Real radius)
 {
-    float deltaTime = gTimer.DeltaTime(); // 獲取幀間時間差
+    Real deltaTime = RDeltaTime(); // 獲取幀間時間差
+    bool lost = false;
     // 更新球的位置
-    ball.pos.x += ball.velocity * ball.acceleration.x * deltaTime;
-    ball.pos.y += ball.velocity * ball.acceleration.y * deltaTime;
+    *pos = RVec2Add(*pos, RVec2Scale(*dir, RMulDt(speed, deltaTime)));
     // 球與磚塊的碰撞檢測 (球的中心點與半徑)
     int index = 0;
-    if (EnemyCollision(ball.pos, ball.radius, &index)) {
-        ball.acceleration.y *= -1; // 碰到磚塊，Y方向反彈
-        PlayerAddScore(10); // 增加分數
-        ExplodTryAdd(ball.pos);
-        EnemyRemove(index);
+    if (EnemyCollision(*pos, &ballMask, &index)) { // 像素精確 (球與敵人貼圖的 alpha)
+        dir->y *= -1; // 碰到磚塊，Y方向反彈
+        EventPush((GameEvent) { .type = EVENT_HIT, .hit = { *pos, index } });
     }
     // 球與牆壁的碰撞檢測
     // 左牆或右牆
-    if ((ball.pos.x - ball.radius) < 0) {
-        ball.pos.x = ball.radius; // 防止穿透
-        ball.acceleration.x *= -1;
+    if ((pos->x - radius) < 0) {
+        pos->x = radius; // 防止穿透
+        dir->x *= -1;
+        EventPush((GameEvent) { .type = EVENT_BOUNCE, .bounce = { *pos, { R(1.0f), 0 } } });
     }
-    if ((ball.pos.x + ball.radius) > SCR_WIDTH) {
-        ball.pos.x = SCR_WIDTH - ball.radius; // 防止穿透
-        ball.acceleration.x *= -1;
+    if ((pos->x + radius) > R(SCR_WIDTH)) {
+        pos->x = R(SCR_WIDTH) - radius; // 防止穿透
+        dir->x *= -1;
+        EventPush((GameEvent) { .type = EVENT_BOUNCE, .bounce = { *pos, { R(-1.0f), 0 } } });
     }
     // 上牆 (遊戲中通常不會撞到上牆就結束，除非是特殊規則)
-    if ((ball.pos.y - ball.radius) < 0) {
-        ball.pos.y = ball.radius; // 防止穿透
-        ball.acceleration.y *= -1;
+    if ((pos->y - radius) < 0) {
+        pos->y = radius; // 防止穿透
+        dir->y *= -1;
+        EventPush((GameEvent) { .type = EVENT_BOUNCE, .bounce = { *pos, { 0, R(1.0f) } } });
     }
-    // 下牆 (球掉落，遊戲結束的邏輯通常在這裡，但目前只是反彈)
-    if ((ball.pos.y + ball.radius) > SCR_HEIGHT) {
-        // 實際遊戲中，這裡可能是 Game Over 或 扣生命值
-        // 目前為了測試，先讓它反彈
-        // ball.pos.y = SCR_HEIGHT - ball.radius; // 防止穿透
-        // ball.acceleration.y *= -1;
-        // 或者重置球
-        BallInit();
-        PlayerInit(PADDLE_W, PADDLE_H); // 可以選擇是否重置玩家分數
+    // 下牆 (球掉落)
+    if ((pos->y + radius) > R(SCR_HEIGHT)) {
+        lost = true;
     }
     // 球与玩家板的碰撞檢測
-    if (PlayerCollision(ball.pos, ball.radius)) {
-        ball.acceleration.y *= -1; // 碰到板子，Y方向反彈
+    if (PlayerCollision(*pos, radius)) {
+        EventPush((GameEvent) { .type = EVENT_BOUNCE, .bounce = { *pos, { 0, R(-1.0f) } } });
+        dir->y *= -1; // 碰到板子，Y方向反彈
         // 可以根據碰撞點微調X方向，增加遊戲性
-        ball.acceleration.x += PlayerPaddleDiff(ball.pos) * 0.5f; // 輕微影響X方向
+        dir->x += RMul(PlayerPaddleDiff(*pos), R(0.5f)); // 輕微影響X方向
         // 重新正規化加速度向量
-        float mag = sqrtf(ball.acceleration.x * ball.acceleration.x + ball.acceleration.y * ball.acceleration.y);
-        if (mag > 0) {
-            ball.acceleration.x /= mag;
-            ball.acceleration.y /= mag;
-        }
+        *dir = RVec2Normalize(*dir);
         // 确保球向上移动
-        if (ball.acceleration.y > -0.1f) { // 如果Y方向太水平或向下，强制向上
-            ball.acceleration.y = -0.5f; // 給一個最小的向上速度分量
+        if (dir->y > R(-0.1f)) { // 如果Y方向太水平或向下，强制向上
+            dir->y = R(-0.5f); // 給一個最小的向上速度分量
             // 再次正規化
-            mag = sqrtf(ball.acceleration.x * ball.acceleration.x + ball.acceleration.y * ball.acceleration.y);
-            if (mag > 0) {
-                ball.acceleration.x /= mag;
-                ball.acceleration.y /= mag;
-            }
+            *dir = RVec2Normalize(*dir);
         }
     }
+    return lost;
 }
 
-// 繪製球
-void BallDraw()
+// 更新球的邏輯
+void BallUpdate()
 {
-    Rect sourceRec = {
-        0.0f,0.0f,
-        (float)ball.af.cellW, // 源矩形寬度
-        (float)ball.af.cellH // 源矩形高度
-    };
-    Rect destRec = {
-        ball.pos.x, // 目標矩形 x
-        ball.pos.y, // 目標矩形 y
-        (float)ball.af.cellW, // 目標矩形寬度
-        (float)ball.af.cellH // 目標矩形高度
-    };
-    Vec2 origin = { (float)ball.af.centerW, (float)ball.af.centerH }; // 繪製原點
-    DrawTexturePro(ball.af.tex, sourceRec, destRec, origin, 0.0F, WHITE); 
-}
\ No newline at end of file
+    Ball* ball = &gWorld->ball;
+    if (BallMove(&ball->pos, &ball->acceleration, ball->velocity, ball->radius)) {
+        // 實際遊戲中，這裡可能是 Game Over 或 扣生命值
+        // 球與玩家的重置在 BallHandleEvents/PlayerHandleEvents 中處理
+        EventPush((GameEvent) { .type = EVENT_BALL_LOST, .lost = { ball->pos } });
+    }
+}
+
+// 批次處理本幀事件：球掉落時重置
+void BallHandleEvents()
+{
+    for (int i = 0; i < EventCount(); i++) {
+        if (EventGet(i)->type == EVENT_BALL_LOST) {
+            BallReset();
+            return;
+        }
+    }
+}
+
+// 將中心位於 pos 的一顆球加入繪製清單
+void BallRenderAt(RenderFrame* f, RVec2 pos)
+{
+    RenderPushSprite(f, &ballAf, pos, 0, RENDER_CELL);
+}
+
+// 將球加入繪製清單
+void BallRender(RenderFrame* f)
+{
+    BallRenderAt(f, gWorld->ball.pos);
+}
+
+// 球的模擬狀態 (快照用)
+StateBlock BallStateBlock()
+{
+    return (StateBlock) { &gWorld->ball, sizeof(Ball) };
+}
+
+// 將球的狀態 (位置、方向、速度) 累加進雜湊值
+uint64_t BallStateHash(uint64_t h)
+{
+    return StateHashBytes(h, &gWorld->ball, sizeof(Ball));
+}
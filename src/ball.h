@@ -1,8 +1,30 @@
 #ifndef __BALL_H__
 #define __BALL_H__
+#include "real.h"
+#include "snapshot.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct RenderFrame RenderFrame; // render.h
+
+// Ball structure (屬於 GameWorld 的模擬狀態)
+typedef struct {
+    RVec2 pos; // 球的中心位置
+    RVec2 acceleration; // 球的加速度方向向量 (單位向量)
+    Real velocity; // 球的速度 (純量)
+    Real radius; // 球的半徑 (用於碰撞)
+} Ball;
+
 // Ball functions
-void BallInit(); // 球初始化
+void BallInit(); // 載入球的貼圖
+void BallMaskInit(); // 產生球的碰撞遮罩 (建立世界之前呼叫一次)
+void BallReset(); // 重設目前世界中的球
 void BallFini();
 void BallUpdate(); // 球邏輯更新
-void BallDraw(); // 球繪製
+bool BallMove(RVec2* pos, RVec2* dir, Real speed, Real radius); // 移動一顆球並處理敵人、牆壁、玩家板，返回是否掉出畫面底部
+void BallHandleEvents(); // 批次處理本幀事件
+void BallRender(RenderFrame* f); // 將球加入繪製清單
+void BallRenderAt(RenderFrame* f, RVec2 pos); // 將中心位於 pos 的一顆球加入繪製清單
+StateBlock BallStateBlock(); // 球的模擬狀態 (快照用)
+uint64_t BallStateHash(uint64_t h); // 將球的狀態累加進雜湊值
 #endif
\ No newline at end of file
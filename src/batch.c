@@ -0,0 +1,157 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime、sysconf (-std=c2x 下需明確要求 POSIX 宣告)
+#include "batch.h"
+#include "arena.h"
+#include "player.h"
+#include "statehash.h"
+#include "world.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BATCH_MAX_THREADS 256
+#define BATCH_STEP (1.0f / 60.0f) // 批次模擬的固定步長 (秒)
+
+// 一個工作執行緒負責的世界範圍 [begin, end)
+typedef struct {
+    GameWorld* worlds;
+    int begin;
+    int end;
+    uint32_t ticks;
+    uint64_t* hashes; // 各世界的最終狀態雜湊值
+    int* scores; // 各世界的最終分數
+} BatchJob;
+
+/**
+ * @brief 單調時鐘 (秒)，不需要 raylib 視窗
+ */
+double BatchClock()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief 可用的邏輯核心數
+ */
+int BatchCpuCount()
+{
+#if defined(_WIN32)
+    int n = pthread_num_processors_np();
+#elif defined(_SC_NPROCESSORS_ONLN)
+    int n = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    int n = 1;
+#endif
+    return n > 0 ? n : 1;
+}
+
+// 工作執行緒：依序把每個世界推進全部 tick (一個世界的狀態在推進期間留在該核心的快取中)
+static void* BatchWorker(void* arg)
+{
+    BatchJob* job = arg;
+    FrameArenaInit(); // 本執行緒的暫存配置器
+    for (int w = job->begin; w < job->end; w++) {
+        WorldBind(&job->worlds[w]);
+        for (uint32_t t = 0; t < job->ticks; t++) {
+            FrameArenaSwap();
+            WorldStep();
+        }
+        job->hashes[w] = StateHashCompute();
+        job->scores[w] = PlayerScore();
+    }
+    WorldBind(NULL);
+    return NULL;
+}
+
+/**
+ * @brief 平行推進多個獨立世界
+ *
+ * @param worlds 世界數量
+ * @param ticks 每個世界推進的 tick 數
+ * @param threads 工作執行緒數量 (<= 0 表示使用全部核心，不超過世界數量)
+ * @param seed 第 i 個世界以 seed 衍生的種子初始化，相同參數的結果與執行緒數量無關
+ * @param pilot 自動駕駛參數 (NULL 表示不啟用)
+ */
+BatchStats BatchRun(int worlds, uint32_t ticks, int threads, uint32_t seed, const AutopilotConfig* pilot)
+{
+    BatchStats stats = { 0 };
+    if (worlds <= 0) {
+        return stats;
+    }
+    if (threads <= 0) {
+        threads = BatchCpuCount();
+    }
+    if (threads > worlds) {
+        threads = worlds;
+    }
+    if (threads > BATCH_MAX_THREADS) {
+        threads = BATCH_MAX_THREADS;
+    }
+    // GameWorld 含快取行對齊的陣列，手動對齊配置 (每個世界的大小為對齊的倍數，相鄰世界不會共用快取行)
+    size_t align = _Alignof(GameWorld);
+    void* raw = malloc(sizeof(GameWorld) * (size_t)worlds + align);
+    uint64_t* hashes = malloc(sizeof(uint64_t) * (size_t)worlds);
+    int* scores = malloc(sizeof(int) * (size_t)worlds);
+    if (raw == NULL || hashes == NULL || scores == NULL) {
+        printf("Error: Cannot allocate %d worlds\n", worlds);
+        free(raw);
+        free(hashes);
+        free(scores);
+        return stats;
+    }
+    GameWorld* world = (GameWorld*)(((uintptr_t)raw + align - 1) & ~(uintptr_t)(align - 1));
+
+    GameWorld* prev = gWorld; // 呼叫端綁定的世界 (互動遊戲)，結束後還原
+    for (int i = 0; i < worlds; i++) {
+        uint32_t worldSeed = seed ^ (uint32_t)(i + 1) * 0x9e3779b9u;
+        WorldInit(&world[i], worldSeed, BATCH_STEP);
+        if (pilot != NULL) {
+            AutopilotEnable(*pilot, worldSeed ^ 0x5bd1e995u);
+        }
+    }
+    WorldBind(prev);
+
+    BatchJob jobs[BATCH_MAX_THREADS];
+    pthread_t tids[BATCH_MAX_THREADS];
+    bool started[BATCH_MAX_THREADS];
+    double t0 = BatchClock();
+    for (int t = 0; t < threads; t++) {
+        jobs[t] = (BatchJob) {
+            .worlds = world,
+            .begin = (int)((int64_t)worlds * t / threads),
+            .end = (int)((int64_t)worlds * (t + 1) / threads),
+            .ticks = ticks,
+            .hashes = hashes,
+            .scores = scores,
+        };
+        started[t] = pthread_create(&tids[t], NULL, BatchWorker, &jobs[t]) == 0;
+        if (!started[t]) {
+            BatchWorker(&jobs[t]); // 無法建立執行緒時在目前執行緒完成
+            WorldBind(prev);
+        }
+    }
+    for (int t = 0; t < threads; t++) {
+        if (started[t]) {
+            pthread_join(tids[t], NULL);
+        }
+    }
+    double elapsed = BatchClock() - t0;
+
+    stats.worlds = worlds;
+    stats.threads = threads;
+    stats.ticks = (uint64_t)worlds * ticks;
+    stats.seconds = elapsed;
+    stats.ticksPerSec = elapsed > 0.0 ? (double)stats.ticks / elapsed : 0.0;
+    for (int i = 0; i < worlds; i++) {
+        stats.totalScore += scores[i];
+    }
+    stats.hash = StateHashBytes(STATE_HASH_SEED, hashes, sizeof(uint64_t) * (size_t)worlds);
+
+    free(raw);
+    free(hashes);
+    free(scores);
+    return stats;
+}
@@ -0,0 +1,25 @@
+#ifndef __BATCH_H__
+#define __BATCH_H__
+#include "autopilot.h"
+#include <stdint.h>
+
+// 無視窗的批次模擬 (平衡調整、長時間穩定性測試)
+// 將 N 個獨立的 GameWorld 平均分配到多個工作執行緒，每個世界以固定 1/60 秒步長推進。
+// 每個執行緒使用自己的每幀暫存配置器，世界之間不共享可寫入的狀態，因此吞吐量隨核心數近似線性成長。
+
+typedef struct BatchStats {
+    int worlds; // 世界數量
+    int threads; // 工作執行緒數量
+    uint64_t ticks; // 所有世界合計推進的 tick 數
+    double seconds; // 實際經過時間 (秒)
+    double ticksPerSec; // 合計吞吐量 (tick/秒)
+    int64_t totalScore; // 所有世界最終分數的總和
+    uint64_t hash; // 所有世界最終狀態雜湊值的組合 (與執行緒數量無關，可用於驗證確定性)
+} BatchStats;
+
+// threads <= 0 時使用全部核心；pilot 不為 NULL 時每個世界都啟用自動駕駛 (否則玩家板不動)
+BatchStats BatchRun(int worlds, uint32_t ticks, int threads, uint32_t seed, const AutopilotConfig* pilot);
+int BatchCpuCount(); // 可用的邏輯核心數
+double BatchClock(); // 單調時鐘 (秒)，無視窗時 raylib 的 GetTime 無法使用
+
+#endif
@@ -0,0 +1,705 @@
+#include "bench.h"
+#include "alloctrack.h"
+#include "arena.h"
+#include "autopilot.h"
+#include "batch.h"
+#include "brickout.h"
+#include "enemy.h"
+#include "env.h"
+#include "event.h"
+#include "multiball.h"
+#include "nearest.h"
+#include "player.h"
+#include "projectile.h"
+#include "raycast.h"
+#include "script.h"
+#include "statehash.h"
+#include "sweep.h"
+#include "world.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ENEMY_BENCH_ROUNDS 6 // 兩種佈局輪流計時的回合數 (每回合交換先後順序，各取最快的一次)
+#define BALL_BENCH_AREA 2048 // 球對球基準測試中每顆球分到的場地面積 (平方像素，約 10% 的覆蓋率)
+#define SWEEP_BENCH_AREA 4096 // 敵人分離基準測試中每個敵人分到的場地面積 (平方像素)
+#define SWEEP_BENCH_BRUTE_TICKS 30 // 兩兩測試的對照只執行的 tick 數
+#define NEAR_BENCH_AREA 2048 // 最近鄰基準測試中每個點分到的場地面積 (平方像素)
+#define NEAR_BENCH_BUILDS 20 // 重複建立索引的次數 (取平均)
+#define NEAR_BENCH_K 8 // kNN 查詢的 k
+#define NEAR_BENCH_RADIUS R(64.0f) // 半徑查詢的半徑
+#define NEAR_BENCH_CHECKS 2000 // 與逐一測試比對的查詢數
+#define FRAME_BENCH_WARMUP (ALLOC_WARMUP_FRAMES + 1) // 幀時間基準測試中每個模式不計時的暖機幀數 (之後的幀內配置都會被追蹤)
+
+/**
+ * @brief 以隨機動作推進向量化環境，輸出 env-step/秒
+ */
+int EnvBench(int n, int steps)
+{
+    Env* env = EnvCreate(n);
+    float* obs = malloc(sizeof(float) * ENV_OBS_SIZE * (size_t)n);
+    float* rewards = malloc(sizeof(float) * (size_t)n);
+    uint8_t* actions = malloc((size_t)n);
+    uint8_t* dones = malloc((size_t)n);
+    if (env == NULL || obs == NULL || rewards == NULL || actions == NULL || dones == NULL) {
+        EnvDestroy(env);
+        free(obs);
+        free(rewards);
+        free(actions);
+        free(dones);
+        return 1;
+    }
+    EnvReset(env, 1u, obs);
+    uint32_t rng = 1u;
+    double reward = 0.0;
+    int episodes = 0;
+    double t0 = BatchClock();
+    for (int s = 0; s < steps; s++) {
+        for (int i = 0; i < n; i++) {
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            actions[i] = (uint8_t)(rng % 3);
+        }
+        EnvStep(env, actions, obs, rewards, dones);
+        for (int i = 0; i < n; i++) {
+            reward += rewards[i];
+            episodes += dones[i];
+        }
+    }
+    double elapsed = BatchClock() - t0;
+    double total = (double)n * steps;
+    printf("[metrics] env n=%d steps=%d time=%.3fs rate=%.0f env-steps/s episodes=%d reward=%.0f\n",
+        n, steps, elapsed, elapsed > 0.0 ? total / elapsed : 0.0, episodes, reward);
+    EnvDestroy(env);
+    free(obs);
+    free(rewards);
+    free(actions);
+    free(dones);
+    return 0;
+}
+
+// 熱冷分離之前的敵人佈局 (基準測試的對照)：每個欄位一個陣列，欄位使用原本較寬的型別，
+// 每個 tick 還要讀取種類 (跳過非活動的敵人)、路徑、點索引與速度
+typedef struct {
+    RVec2* pos;
+    RVec2* dirVec; // 單位方向 (每個 tick 乘上速度)
+    int* pathSelect;
+    int* currPathCount;
+    int* eType;
+    Real* speed;
+} EnemyWide;
+
+// 分離前的路徑跟隨 (移動規則與 ScriptRun 的 OP_FOLLOW 相同：不越過路徑點，到達後瞄準下一點)
+static void EnemyWideUpdate(EnemyWide e, int n, Real dt, RealWide reach2)
+{
+    for (int i = 0; i < n; i++) {
+        if (e.eType[i] == ENEMY_NONE) {
+            continue;
+        }
+        const EnemyPath* path = &enemyPath[e.pathSelect[i]];
+        RVec2 point = path->points[e.currPathCount[i]];
+        RVec2 step = RVec2Scale(e.dirVec[i], RMulDt(e.speed[i], dt));
+        RVec2 to = RVec2Sub(point, e.pos[i]);
+        bool reached;
+        if (RMulWide(step.x, to.x) + RMulWide(step.y, to.y) <= 0 || RVec2LengthSqr(step) >= RVec2LengthSqr(to)) {
+            e.pos[i] = point;
+            reached = true;
+        } else {
+            e.pos[i] = RVec2Add(e.pos[i], step);
+            reached = RVec2DistanceSqr(e.pos[i], point) < reach2;
+        }
+        if (reached) {
+            e.currPathCount[i] = e.currPathCount[i] + 1 < path->pointCount ? e.currPathCount[i] + 1 : 0;
+            e.dirVec[i] = RVec2Normalize(RVec2Sub(path->points[e.currPathCount[i]], e.pos[i]));
+        }
+    }
+}
+
+/**
+ * @brief 以兩種佈局推進 n 個沿路徑移動的敵人 (不受 MAX_ENEMYS 限制)，輸出每個敵人每 tick 讀寫的位元組數與更新吞吐量
+ * 分離後的一側直接執行遊戲中的 ScriptRun (與 EnemyUpdate 相同的呼叫，敵人都執行巡邏腳本)，熱資料以 ScriptView 傳入。
+ * 兩種佈局輪流計時 ENEMY_BENCH_ROUNDS 回合並交換先後順序，各取最快的一次，避免第一次執行的暖機成本偏向其中一方。
+ * 兩者由相同的初始狀態出發並推進相同的 tick 數，最後比對位置 (兩者的捨入順序不同，輸出最大偏差)。
+ */
+int EnemyBench(int n, int ticks)
+{
+    EnemyWide w = {
+        .pos = malloc(sizeof(RVec2) * (size_t)n),
+        .dirVec = malloc(sizeof(RVec2) * (size_t)n),
+        .pathSelect = malloc(sizeof(int) * (size_t)n),
+        .currPathCount = malloc(sizeof(int) * (size_t)n),
+        .eType = malloc(sizeof(int) * (size_t)n),
+        .speed = malloc(sizeof(Real) * (size_t)n),
+    };
+    ScriptView v = {
+        .pos = malloc(sizeof(RVec2) * (size_t)n),
+        .vel = malloc(sizeof(RVec2) * (size_t)n),
+        .target = malloc(sizeof(uint16_t) * (size_t)n),
+        .pc = malloc((size_t)n),
+        .counter = malloc(sizeof(uint16_t) * (size_t)n),
+        .speed = w.speed,
+        .count = n,
+    };
+    int ok = w.pos != NULL && w.dirVec != NULL && w.pathSelect != NULL && w.currPathCount != NULL && w.eType != NULL && w.speed != NULL
+        && v.pos != NULL && v.vel != NULL && v.target != NULL && v.pc != NULL && v.counter != NULL;
+    if (ok) {
+        RVec2 diveAt = { R(SCR_WIDTH / 2.0f), R(SCR_HEIGHT - 50.0f) };
+        for (int i = 0; i < n; i++) { // 平均分配到各路徑與各起點
+            int path = i % MAX_PATHS;
+            int point = (i / MAX_PATHS) % enemyPath[path].pointCount;
+            uint16_t next = EnemyPathNext((uint16_t)(path * MAX_POINTS + point));
+            w.pos[i] = v.pos[i] = enemyPath[path].points[point];
+            w.pathSelect[i] = path;
+            w.currPathCount[i] = next % MAX_POINTS;
+            w.eType[i] = ENEMY_FLY + i % (ENEMY_NUMS - 1);
+            w.speed[i] = R(200.0f);
+            w.dirVec[i] = RVec2Normalize(RVec2Sub(EnemyPathPoint(next), w.pos[i]));
+            v.target[i] = next;
+            ScriptStart(v, i, SCRIPT_PATROL, diveAt);
+        }
+        Real dt = R(1.0f / 60.0f);
+        RealWide reach2 = RMulWide(REACH_THRESH, REACH_THRESH);
+        double wideSec = 0.0, hotSec = 0.0;
+        for (int r = 0; r < ENEMY_BENCH_ROUNDS; r++) {
+            for (int k = 0; k < 2; k++) {
+                bool hot = (k ^ r) & 1; // 奇數回合先執行分離後的佈局
+                double t0 = BatchClock();
+                for (int t = 0; t < ticks; t++) {
+                    if (hot) {
+                        ScriptRun(v, dt, diveAt);
+                    } else {
+                        EnemyWideUpdate(w, n, dt, reach2);
+                    }
+                }
+                double sec = BatchClock() - t0;
+                double* best = hot ? &hotSec : &wideSec;
+                *best = r == 0 || sec < *best ? sec : *best;
+            }
+        }
+        float maxDiff = 0.0f;
+        for (int i = 0; i < n; i++) {
+            float dx = fabsf(RToFloat(v.pos[i].x - w.pos[i].x)), dy = fabsf(RToFloat(v.pos[i].y - w.pos[i].y));
+            maxDiff = dx > maxDiff ? dx : maxDiff;
+            maxDiff = dy > maxDiff ? dy : maxDiff;
+        }
+        // 每個 tick 必定讀寫的欄位 (切換目標點時的冷讀取與共用的腳本位元組碼不計)
+        size_t wideBytes = sizeof(RVec2) * 2 + sizeof(int) * 3 + sizeof(Real);
+        size_t hotBytes = sizeof(RVec2) * 2 + sizeof(uint16_t) * 2 + sizeof(uint8_t);
+        double updates = (double)n * ticks;
+        printf("[metrics] enemy layout n=%d ticks=%d rounds=%d before=%zuB/enemy %.1f Mupdates/s (%.2f GB/s) after=%zuB/enemy %.1f Mupdates/s (%.2f GB/s) speedup=%.2fx maxDiff=%.3fpx\n",
+            n, ticks, ENEMY_BENCH_ROUNDS, wideBytes, wideSec > 0.0 ? updates / wideSec / 1e6 : 0.0, wideSec > 0.0 ? updates * wideBytes / wideSec / 1e9 : 0.0,
+            hotBytes, hotSec > 0.0 ? updates / hotSec / 1e6 : 0.0, hotSec > 0.0 ? updates * hotBytes / hotSec / 1e9 : 0.0,
+            hotSec > 0.0 ? wideSec / hotSec : 0.0, maxDiff);
+    }
+    free(w.pos);
+    free(w.dirVec);
+    free(w.pathSelect);
+    free(w.currPathCount);
+    free(w.eType);
+    free(w.speed);
+    free(v.pos);
+    free(v.vel);
+    free(v.target);
+    free(v.pc);
+    free(v.counter);
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief 以 n 個敵人執行行為腳本 (不受 MAX_ENEMYS 限制)，輸出腳本指令/毫秒
+ */
+int ScriptBench(int n, int ticks)
+{
+    ScriptView v = {
+        .pos = malloc(sizeof(RVec2) * (size_t)n),
+        .vel = malloc(sizeof(RVec2) * (size_t)n),
+        .target = malloc(sizeof(uint16_t) * (size_t)n),
+        .pc = malloc((size_t)n),
+        .counter = malloc(sizeof(uint16_t) * (size_t)n),
+        .count = n,
+    };
+    Real* speed = malloc(sizeof(Real) * (size_t)n);
+    v.speed = speed;
+    int ok = v.pos != NULL && v.vel != NULL && v.target != NULL && v.pc != NULL && v.counter != NULL && speed != NULL;
+    RVec2 diveAt = { R(SCR_WIDTH / 2.0f), R(SCR_HEIGHT - 50.0f) };
+    if (ok) {
+        for (int i = 0; i < n; i++) { // 平均分配到各路徑、各起點與各腳本
+            int path = i % MAX_PATHS;
+            int point = (i / MAX_PATHS) % enemyPath[path].pointCount;
+            v.pos[i] = enemyPath[path].points[point];
+            v.target[i] = EnemyPathNext((uint16_t)(path * MAX_POINTS + point));
+            speed[i] = R(200.0f);
+            ScriptStart(v, i, (ScriptId)(i % SCRIPT_NUMS), diveAt);
+        }
+        uint64_t steps = 0;
+        double t0 = BatchClock();
+        for (int t = 0; t < ticks; t++) {
+            steps += ScriptRun(v, R(1.0f / 60.0f), diveAt);
+        }
+        double ms = (BatchClock() - t0) * 1000.0;
+        printf("[metrics] script enemies=%d ticks=%d steps=%llu time=%.3fms rate=%.0f steps/ms\n",
+            n, ticks, (unsigned long long)steps, ms, ms > 0.0 ? (double)steps / ms : 0.0);
+    }
+    free(v.pos);
+    free(v.vel);
+    free(v.target);
+    free(v.pc);
+    free(v.counter);
+    free(speed);
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief 在敵人滿載的世界中投射 n 條隨機射線，輸出格子與逐一測試兩種版本的射線/秒，並比對兩者的結果
+ */
+int RayBench(int n)
+{
+    GameWorld* world = malloc(sizeof(GameWorld));
+    RVec2* origin = malloc(sizeof(RVec2) * (size_t)n);
+    RVec2* dir = malloc(sizeof(RVec2) * (size_t)n);
+    if (world == NULL || origin == NULL || dir == NULL) {
+        free(world);
+        free(origin);
+        free(dir);
+        return 1;
+    }
+    WorldInit(world, 1u, 1.0f / 60.0f);
+    for (int k = 0; world->enemys.count < MAX_ENEMYS; k++) { // 各種類、各路徑平均分配
+        EnemyAddBatch((EnemyType)(ENEMY_FLY + k % (ENEMY_NUMS - 1)), k % MAX_PATHS, R(200.0f), 10);
+    }
+    for (int t = 0; t < 60; t++) {
+        FrameArenaSwap(); // 子系統的每幀暫存資料只在本 tick 內使用
+        WorldStep();
+    }
+    RaycastBuild();
+    uint32_t rng = 1u;
+    for (int i = 0; i < n; i++) {
+        uint32_t r[3];
+        for (int k = 0; k < 3; k++) {
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            r[k] = rng;
+        }
+        origin[i] = (RVec2) { RFromInt((int)(r[0] % SCR_WIDTH)), RFromInt((int)(r[1] % SCR_HEIGHT)) };
+        Real turns = RFromFloat((float)(r[2] >> 8) / (float)(1u << 24));
+        dir[i] = (RVec2) { RCosTurns(turns), RSinTurns(turns) };
+    }
+    int hits[RAY_HIT_WALL + 1] = { 0 };
+    RayHit hit;
+    double t0 = BatchClock();
+    for (int i = 0; i < n; i++) {
+        hits[Raycast(origin[i], dir[i], R(1200.0f), RAY_ALL, &hit) ? hit.type : RAY_HIT_NONE]++;
+    }
+    double gridSec = BatchClock() - t0;
+    int linearHits = 0;
+    t0 = BatchClock();
+    for (int i = 0; i < n; i++) {
+        linearHits += RaycastLinear(origin[i], dir[i], R(1200.0f), RAY_ALL, &hit) && hit.type == RAY_HIT_ENEMY;
+    }
+    double linearSec = BatchClock() - t0;
+    int mismatches = 0;
+    for (int i = 0; i < n; i++) {
+        RayHit a, b;
+        bool ha = Raycast(origin[i], dir[i], R(1200.0f), RAY_ALL, &a);
+        bool hb = RaycastLinear(origin[i], dir[i], R(1200.0f), RAY_ALL, &b);
+        mismatches += ha != hb || (ha && (a.type != b.type || a.index != b.index || a.t != b.t));
+    }
+    printf("[metrics] raycast enemies=%d rays=%d grid=%.2f Mrays/s linear=%.2f Mrays/s hits enemy=%d paddle=%d wall=%d none=%d linearEnemy=%d mismatches=%d\n",
+        world->enemys.count, n, gridSec > 0.0 ? n / gridSec / 1e6 : 0.0, linearSec > 0.0 ? n / linearSec / 1e6 : 0.0,
+        hits[RAY_HIT_ENEMY], hits[RAY_HIT_PADDLE], hits[RAY_HIT_WALL], hits[RAY_HIT_NONE], linearHits, mismatches);
+    free(world);
+    free(origin);
+    free(dir);
+    return mismatches == 0 ? 0 : 1;
+}
+
+// 擊中事件計數 (LaserBench 的事件監聽函數)
+static void CountHits(const GameEvent* ev, void* user)
+{
+    if (ev->type == EVENT_HIT) {
+        (*(long*)user)++;
+    }
+}
+
+/**
+ * @brief 維持 live 發雷射與滿載的敵人推進 ticks 個 tick，輸出每個 tick 的模擬耗時
+ */
+int LaserBench(int live, int ticks)
+{
+    GameWorld* world = malloc(sizeof(GameWorld));
+    if (world == NULL) {
+        return 1;
+    }
+    WorldInit(world, 1u, 1.0f / 60.0f);
+    long hits = 0;
+    EventSetTap(CountHits, &hits);
+    uint32_t rng = 1u;
+    double seconds = 0.0, maxTick = 0.0;
+    for (int t = 0; t < ticks; t++) {
+        for (int k = 0; world->enemys.count + 10 <= MAX_ENEMYS; k++) { // 補滿被擊落的敵人
+            EnemyAddBatch((EnemyType)(ENEMY_FLY + k % (ENEMY_NUMS - 1)), (t + k) % MAX_PATHS, R(200.0f), 10);
+        }
+        while (world->projectiles.live < live) { // 補滿雷射 (平均分布在整個畫面)
+            rng ^= rng << 13;
+            rng ^= rng >> 17;
+            rng ^= rng << 5;
+            int x = (int)(rng % (SCR_WIDTH - PROJECTILE_W));
+            int y = (int)((rng >> 10) % SCR_HEIGHT);
+            if (!ProjectileFire((RVec2) { RFromInt(x), RFromInt(y) })) {
+                break;
+            }
+        }
+        FrameArenaSwap();
+        double t0 = BatchClock();
+        WorldStep();
+        double dt = BatchClock() - t0;
+        seconds += dt;
+        if (dt > maxTick) {
+            maxTick = dt;
+        }
+    }
+    printf("[metrics] laser live=%d ticks=%d step=%.3fms/tick max=%.3fms budget=%.3fms hits=%ld\n",
+        live, ticks, ticks > 0 ? seconds * 1000.0 / ticks : 0.0, maxTick * 1000.0, 1000.0 / 60.0, hits);
+    free(world);
+    return 0;
+}
+
+/**
+ * @brief 以自動駕駛推進一個世界 ticks 個 tick，輸出數值模式、每個 tick 的耗時與最終狀態雜湊
+ * 同一命令分別在 float 與 -DFIXED_POINT 建置下執行即為兩者的效能比較；以 -hashlog 開啟記錄檔時寫入每個 tick 的雜湊值，
+ * 兩個建置 (例如 -O0 與 -O3 -ffast-math) 的記錄檔再以 -hashdiff 比對，定點模式下應完全相同。
+ */
+int RealBench(int ticks, const AutopilotConfig* pilot)
+{
+    GameWorld* world = malloc(sizeof(GameWorld));
+    if (world == NULL) {
+        return 1;
+    }
+    WorldInit(world, 1u, 1.0f / 60.0f);
+    AutopilotEnable(*pilot, 1u);
+    double t0 = BatchClock();
+    for (int t = 0; t < ticks; t++) {
+        FrameArenaSwap();
+        WorldStep();
+        StateHashTick(); // 以 -hashlog 開啟記錄檔時寫入
+    }
+    double seconds = BatchClock() - t0;
+#ifdef FIXED_POINT
+    char mode[16];
+    snprintf(mode, sizeof(mode), "Q%d.%d", 32 - FIXED_FRAC_BITS, FIXED_FRAC_BITS);
+#else
+    const char* mode = "float";
+#endif
+    printf("[metrics] real mode=%s ticks=%d step=%.3fus/tick rate=%.0f ticks/s score=%d hash=%016llx\n",
+        mode, ticks, ticks > 0 ? seconds * 1e6 / ticks : 0.0, seconds > 0.0 ? ticks / seconds : 0.0,
+        PlayerScore(), (unsigned long long)StateHashLast());
+    WorldBind(NULL);
+    free(world);
+    return 0;
+}
+
+/**
+ * @brief 在密度固定的正方形場地中推進 n 顆互相碰撞的球 (不受 MULTIBALL_MAX 限制)，輸出每個 tick 的碰撞耗時與測試的球對數
+ */
+int BallBench(int n, int ticks)
+{
+    int side = (int)sqrt((double)n * BALL_BENCH_AREA); // 場地邊長 (像素)
+    int cols = (side + BALL_SIZE - 1) / BALL_SIZE;
+    BallView v = {
+        .pos = malloc(sizeof(RVec2) * (size_t)n),
+        .dir = malloc(sizeof(RVec2) * (size_t)n),
+        .speed = malloc(sizeof(Real) * (size_t)n),
+        .count = n,
+        .radius = R(BALL_RADIUS),
+    };
+    BallGrid g = {
+        .cols = cols,
+        .rows = cols,
+        .cellStart = malloc(sizeof(uint32_t) * ((size_t)cols * cols + 1)),
+        .items = malloc(sizeof(uint32_t) * (size_t)n),
+        .cellOf = malloc(sizeof(uint32_t) * (size_t)n),
+    };
+    int ok = v.pos != NULL && v.dir != NULL && v.speed != NULL && g.cellStart != NULL && g.items != NULL && g.cellOf != NULL;
+    if (ok) {
+        uint32_t rng = 1u;
+        for (int i = 0; i < n; i++) {
+            uint32_t r[3];
+            for (int k = 0; k < 3; k++) {
+                rng ^= rng << 13;
+                rng ^= rng >> 17;
+                rng ^= rng << 5;
+                r[k] = rng;
+            }
+            v.pos[i] = (RVec2) { RFromInt(BALL_SIZE / 2 + (int)(r[0] % (uint32_t)(side - BALL_SIZE))), RFromInt(BALL_SIZE / 2 + (int)(r[1] % (uint32_t)(side - BALL_SIZE))) };
+            Real turns = RFromFloat((float)(r[2] >> 8) / (float)(1u << 24));
+            v.dir[i] = (RVec2) { RCosTurns(turns), RSinTurns(turns) };
+            v.speed[i] = R(350.0f);
+        }
+        double energy0 = 0.0;
+        for (int i = 0; i < n; i++) {
+            energy0 += (double)RToFloat(v.speed[i]) * RToFloat(v.speed[i]);
+        }
+        Real step = R(1.0f / 60.0f);
+        Real lo = v.radius, hi = RFromInt(side) - v.radius;
+        uint32_t pairs = 0;
+        uint64_t contacts = 0;
+        double moveSec = 0.0, collideSec = 0.0;
+        for (int t = 0; t < ticks; t++) {
+            double t0 = BatchClock();
+            for (int i = 0; i < n; i++) { // 移動並在場地邊緣反彈
+                v.pos[i] = RVec2Add(v.pos[i], RVec2Scale(v.dir[i], RMulDt(v.speed[i], step)));
+                if ((v.pos[i].x < lo && v.dir[i].x < 0) || (v.pos[i].x > hi && v.dir[i].x > 0)) {
+                    v.dir[i].x = -v.dir[i].x;
+                }
+                if ((v.pos[i].y < lo && v.dir[i].y < 0) || (v.pos[i].y > hi && v.dir[i].y > 0)) {
+                    v.dir[i].y = -v.dir[i].y;
+                }
+            }
+            double t1 = BatchClock();
+            contacts += BallCollide(v, g, &pairs);
+            collideSec += BatchClock() - t1;
+            moveSec += t1 - t0;
+        }
+        double energy = 0.0;
+        for (int i = 0; i < n; i++) {
+            energy += (double)RToFloat(v.speed[i]) * RToFloat(v.speed[i]);
+        }
+        double perTick = ticks > 0 ? 1.0 / ticks : 0.0;
+        printf("[metrics] balls n=%d ticks=%d arena=%dpx grid=%dx%d collide=%.3fms/tick move=%.3fms/tick pairs=%.0f/tick (%.2f per ball) contacts=%.0f/tick energy=%.4f\n",
+            n, ticks, side, cols, cols, collideSec * 1000.0 * perTick, moveSec * 1000.0 * perTick, pairs * perTick,
+            n > 0 ? pairs * perTick / n : 0.0, contacts * perTick, energy0 > 0.0 ? energy / energy0 : 0.0);
+    }
+    free(v.pos);
+    free(v.dir);
+    free(v.speed);
+    free(g.cellStart);
+    free(g.items);
+    free(g.cellOf);
+    return ok ? 0 : 1;
+}
+
+/**
+ * @brief 在高度固定、寬度隨 n 延伸的帶狀場地中推進 n 個敵人並互相分離 (不受 MAX_ENEMYS 限制)，輸出掃描與剪除每個 tick 的耗時；
+ * 前 SWEEP_BENCH_BRUTE_TICKS 個 tick 同時以兩兩測試比對重疊的對數並量測耗時
+ */
+int SweepBench(int n, int ticks)
+{
+    int width = (int)((long)n * SWEEP_BENCH_AREA / SCR_HEIGHT); // 密度固定
+    RVec2* pos = malloc(sizeof(RVec2) * (size_t)n);
+    RVec2* vel = malloc(sizeof(RVec2) * (size_t)n);
+    RVec2* push = malloc(sizeof(RVec2) * (size_t)n);
+    RVec2* brutePush = malloc(sizeof(RVec2) * (size_t)n);
+    uint32_t* order = malloc(sizeof(uint32_t) * (size_t)n);
+    int ok = pos != NULL && vel != NULL && push != NULL && brutePush != NULL && order != NULL && width > 0;
+    int mismatches = 0;
+    if (ok) {
+        uint32_t rng = 1u;
+        for (int i = 0; i < n; i++) {
+            uint32_t r[3];
+            for (int k = 0; k < 3; k++) {
+                rng ^= rng << 13;
+                rng ^= rng >> 17;
+                rng ^= rng << 5;
+                r[k] = rng;
+            }
+            pos[i] = (RVec2) { RFromInt((int)(r[0] % (uint32_t)width)), RFromInt((int)(r[1] % SCR_HEIGHT)) };
+            Real turns = RFromFloat((float)(r[2] >> 8) / (float)(1u << 24));
+            vel[i] = (RVec2) { RMul(RCosTurns(turns), R(200.0f)), RMul(RSinTurns(turns), R(200.0f)) };
+        }
+        SweepList list = { order, 0 };
+        SweepSort(&list, pos, n); // 第一次排序從索引順序開始 (不計入)
+        Real step = R(1.0f / 60.0f);
+        uint64_t shifts = 0, contacts = 0;
+        uint32_t tested = 0, bruteTested = 0;
+        int bruteTicks = 0;
+        double sweepSec = 0.0, bruteSec = 0.0;
+        for (int t = 0; t < ticks; t++) {
+            for (int i = 0; i < n; i++) { // 等速移動並在場地邊緣反彈 (移動連貫)
+                pos[i] = RVec2Add(pos[i], RVec2ScaleDt(vel[i], step));
+                if ((pos[i].x < 0 && vel[i].x < 0) || (pos[i].x > RFromInt(width) && vel[i].x > 0)) {
+                    vel[i].x = -vel[i].x;
+                }
+                if ((pos[i].y < 0 && vel[i].y < 0) || (pos[i].y > R(SCR_HEIGHT) && vel[i].y > 0)) {
+                    vel[i].y = -vel[i].y;
+                }
+            }
+            double t0 = BatchClock();
+            shifts += SweepSort(&list, pos, n);
+            memset(push, 0, sizeof(RVec2) * (size_t)n);
+            uint32_t c = SweepPairs(&list, pos, ENEMY_SEPARATION, push, &tested);
+            sweepSec += BatchClock() - t0;
+            contacts += c;
+            if (t < SWEEP_BENCH_BRUTE_TICKS) { // 同一組位置的兩兩測試 (推開量丟棄)
+                memset(brutePush, 0, sizeof(RVec2) * (size_t)n);
+                t0 = BatchClock();
+                mismatches += SweepPairsBrute(pos, n, ENEMY_SEPARATION, brutePush, &bruteTested) != c;
+                bruteSec += BatchClock() - t0;
+                bruteTicks++;
+            }
+            SweepApply(pos, push, n, ENEMY_SEPARATION_RATE, ENEMY_SEPARATION_MAX_STEP);
+        }
+        double sweepMs = ticks > 0 ? sweepSec * 1000.0 / ticks : 0.0;
+        double bruteMs = bruteTicks > 0 ? bruteSec * 1000.0 / bruteTicks : 0.0;
+        double perTick = ticks > 0 ? 1.0 / ticks : 0.0;
+        printf("[metrics] sweep enemies=%d ticks=%d arena=%dx%d sweep=%.3fms/tick brute=%.3fms/tick speedup=%.1fx shifts=%.0f/tick tested=%.0f/tick (%.2f per enemy) brute tested=%.0f/tick contacts=%.0f/tick mismatches=%d\n",
+            n, ticks, width, SCR_HEIGHT, sweepMs, bruteMs, sweepMs > 0.0 ? bruteMs / sweepMs : 0.0, shifts * perTick,
+            tested * perTick, n > 0 ? tested * perTick / n : 0.0, bruteTicks > 0 ? (double)bruteTested / bruteTicks : 0.0,
+            contacts * perTick, mismatches);
+    }
+    free(pos);
+    free(vel);
+    free(push);
+    free(brutePush);
+    free(order);
+    return ok && mismatches == 0 ? 0 : 1;
+}
+
+// 逐一測試所有點的 k 個最近點 (距離相同時索引較小者優先，與 NearestKnn 的順序相同)
+static int NearestBrute(const RVec2* pos, int n, RVec2 p, int k, uint32_t* out)
+{
+    RealWide dist[NEAR_BENCH_K];
+    int found = 0;
+    for (int i = 0; i < n; i++) {
+        RealWide d2 = RVec2DistanceSqr(pos[i], p);
+        if (found == k && d2 >= dist[k - 1]) {
+            continue;
+        }
+        int j = found < k ? found++ : k - 1;
+        while (j > 0 && d2 < dist[j - 1]) {
+            dist[j] = dist[j - 1];
+            out[j] = out[j - 1];
+            j--;
+        }
+        dist[j] = d2;
+        out[j] = (uint32_t)i;
+    }
+    return found;
+}
+
+/**
+ * @brief 以 n 個隨機分布的點建立最近鄰索引並回答 q 個查詢，輸出建立時間與各種查詢的查詢/秒，並與逐一測試比對
+ */
+int NearestBench(int n, int q)
+{
+    int side = (int)sqrt((double)n * NEAR_BENCH_AREA);
+    RVec2* pos = malloc(sizeof(RVec2) * (size_t)n);
+    RVec2* query = malloc(sizeof(RVec2) * (size_t)q);
+    uint32_t* cellStart = malloc(sizeof(uint32_t) * ((size_t)NEAREST_MAX_CELLS(n) + 1));
+    uint32_t* items = malloc(sizeof(uint32_t) * (size_t)n);
+    uint32_t* cellOf = malloc(sizeof(uint32_t) * (size_t)n);
+    int32_t* nearest = malloc(sizeof(int32_t) * (size_t)q);
+    uint32_t* found = malloc(sizeof(uint32_t) * (size_t)n);
+    int ok = pos != NULL && query != NULL && cellStart != NULL && items != NULL && cellOf != NULL && nearest != NULL && found != NULL && n > 0;
+    int mismatches = 0;
+    if (ok) {
+        uint32_t rng = 1u;
+        for (int i = 0; i < n + q; i++) {
+            uint32_t r[2];
+            for (int k = 0; k < 2; k++) {
+                rng ^= rng << 13;
+                rng ^= rng >> 17;
+                rng ^= rng << 5;
+                r[k] = rng;
+            }
+            RVec2 p = { RFromFloat((float)(r[0] >> 8) / (float)(1u << 24) * side), RFromFloat((float)(r[1] >> 8) / (float)(1u << 24) * side) };
+            if (i < n) {
+                pos[i] = p;
+            } else {
+                query[i - n] = p;
+            }
+        }
+        NearestIndex ix;
+        double t0 = BatchClock();
+        for (int b = 0; b < NEAR_BENCH_BUILDS; b++) {
+            NearestBuild(&ix, pos, n, cellStart, items, cellOf);
+        }
+        double buildMs = (BatchClock() - t0) * 1000.0 / NEAR_BENCH_BUILDS;
+        Real maxDist = RFromInt(2 * side);
+        t0 = BatchClock();
+        NearestBatch(&ix, query, q, maxDist, nearest);
+        double nearestSec = BatchClock() - t0;
+        uint32_t knn[NEAR_BENCH_K];
+        t0 = BatchClock();
+        for (int i = 0; i < q; i++) {
+            NearestKnn(&ix, query[i], NEAR_BENCH_K, maxDist, knn);
+        }
+        double knnSec = BatchClock() - t0;
+        long radiusFound = 0;
+        t0 = BatchClock();
+        for (int i = 0; i < q; i++) {
+            radiusFound += NearestRadius(&ix, query[i], NEAR_BENCH_RADIUS, found, n);
+        }
+        double radiusSec = BatchClock() - t0;
+        int checks = q < NEAR_BENCH_CHECKS ? q : NEAR_BENCH_CHECKS;
+        uint32_t brute[NEAR_BENCH_K];
+        t0 = BatchClock();
+        for (int i = 0; i < checks; i++) {
+            int a = NearestKnn(&ix, query[i], NEAR_BENCH_K, maxDist, knn);
+            int b = NearestBrute(pos, n, query[i], NEAR_BENCH_K, brute);
+            int same = a == b && nearest[i] == (int32_t)brute[0];
+            for (int k = 0; same && k < a; k++) {
+                same = knn[k] == brute[k];
+            }
+            mismatches += !same;
+        }
+        double bruteSec = BatchClock() - t0;
+        printf("[metrics] nearest points=%d queries=%d grid=%dx%d cell=%dpx build=%.3fms (%.1f Mpoints/s) nearest=%.2f Mq/s knn%d=%.2f Mq/s radius=%.2f Mq/s (%.1f hits) bruteKnn=%.0f q/s mismatches=%d/%d\n",
+            n, q, ix.cols, ix.rows, ix.cellSize, buildMs, buildMs > 0.0 ? n / buildMs / 1000.0 : 0.0,
+            nearestSec > 0.0 ? q / nearestSec / 1e6 : 0.0, NEAR_BENCH_K, knnSec > 0.0 ? q / knnSec / 1e6 : 0.0,
+            radiusSec > 0.0 ? q / radiusSec / 1e6 : 0.0, q > 0 ? (double)radiusFound / q : 0.0,
+            bruteSec > 0.0 ? checks / bruteSec : 0.0, mismatches, checks);
+    }
+    free(pos);
+    free(query);
+    free(cellStart);
+    free(items);
+    free(cellOf);
+    free(nearest);
+    free(found);
+    return ok && mismatches == 0 ? 0 : 1;
+}
+
+/**
+ * @brief 不限制幀率，依序以循序模式與管線模式各執行 frames 幀，輸出平均與最長的幀時間
+ * 同時檢查穩定狀態：推進世界的執行緒的暫存配置器不曾用滿，暖機後主執行緒與模擬執行緒的幀內都沒有任何配置 (以 -DALLOC_TRACK 編譯時追蹤)。
+ *
+ * @return 穩定狀態的檢查失敗時返回 1
+ */
+int FrameBench(int frames, int lasers, void (*frame)())
+{
+    SetTargetFPS(0);
+    GameSetStress(lasers);
+    int failed = 0;
+    for (int mode = 0; mode < 2; mode++) {
+        if (mode == 1) {
+            GamePipelineStart();
+        }
+        for (int k = 0; k < FRAME_BENCH_WARMUP && !WindowShouldClose(); k++) {
+            frame();
+        }
+        double seconds = 0.0, maxFrame = 0.0;
+        uint32_t allocs0 = AllocTrackSteadyAllocs();
+        int n = 0;
+        double t0 = BatchClock();
+        for (; n < frames && !WindowShouldClose(); n++) {
+            frame();
+            double t1 = BatchClock();
+            seconds += t1 - t0;
+            maxFrame = t1 - t0 > maxFrame ? t1 - t0 : maxFrame;
+            t0 = t1;
+        }
+        GamePipelineStop();
+        uint32_t allocs = AllocTrackSteadyAllocs() - allocs0; // 主執行緒與模擬執行緒
+        FrameArenaStats arena = GameArenaStats();
+        bool steady = arena.overflows == 0 && arena.highWater < arena.capacity && allocs == 0;
+        failed |= !steady;
+        printf("[metrics] frame mode=%s lasers=%d frames=%d avg=%.3fms max=%.3fms fps=%.0f arena=%zu/%zu overflows=%u allocs=%u steady=%d\n",
+            mode == 0 ? "sequential" : "pipeline", lasers, n, n > 0 ? seconds * 1000.0 / n : 0.0, maxFrame * 1000.0,
+            seconds > 0.0 ? n / seconds : 0.0, arena.highWater, arena.capacity, arena.overflows, allocs, steady);
+    }
+    GameSetStress(0);
+    return failed;
+}
@@ -0,0 +1,19 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+#include "autopilot.h"
+
+// 命令列基準測試 (main.c 的 -xxxbench 選項)
+// 每個函數執行一次量測並輸出一行 [metrics]，返回程式的結束碼 (比對失敗或配置失敗時非 0)。
+
+int EnvBench(int n, int steps); // 以隨機動作推進向量化環境，輸出 env-step/秒
+int EnemyBench(int n, int ticks); // 熱冷分離前後的敵人佈局，輸出每個敵人讀寫的位元組數與更新吞吐量
+int ScriptBench(int n, int ticks); // 以 n 個敵人執行行為腳本，輸出腳本指令/毫秒
+int RayBench(int n); // 投射 n 條隨機射線，比較格子與逐一測試
+int LaserBench(int live, int ticks); // 維持 live 發雷射與滿載的敵人，輸出每個 tick 的模擬耗時
+int RealBench(int ticks, const AutopilotConfig* pilot); // 以自動駕駛推進一個世界，輸出數值模式 (float/定點)、每個 tick 的耗時與狀態雜湊
+int BallBench(int n, int ticks); // n 顆互相碰撞的球，輸出每個 tick 的碰撞耗時
+int SweepBench(int n, int ticks); // n 個敵人互相分離，比較掃描與剪除與兩兩測試
+int NearestBench(int n, int q); // n 個點的最近鄰索引，輸出建立時間與查詢吞吐量
+int FrameBench(int frames, int lasers, void (*frame)()); // 以循序與管線模式各執行 frames 幀 (需要視窗)，輸出幀時間
+
+#endif
@@ -1,5 +1,6 @@
 #ifndef __BRICK_OUT_H__
 #define __BRICK_OUT_H__
+#include "arena.h"
 #include "raylib.h"
 
 ////////////////////////////////////////
@@ -26,5 +27,9 @@ void GameInit();     // 遊戲初始化
 void GameFinish();   // 遊戲結束清理
 void GameUpdate();   // 遊戲邏輯更新
 void GameDraw();     // 遊戲畫面繪製
+void GamePipelineStart(); // 管線模式：模擬執行緒推進下一個 tick 的同時主執行緒繪製上一個
+void GamePipelineStop();  // 結束模擬執行緒，回到循序模式
+void GameSetStress(int lasers); // 幀時間基準測試：每個 tick 補滿敵人與雷射 (0 表示關閉)
+FrameArenaStats GameArenaStats(); // 推進世界的執行緒的暫存配置器統計 (管線模式須先結束)
 
 #endif
\ No newline at end of file
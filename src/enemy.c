@@ -1,28 +1,27 @@
 #include "enemy.h"
 #include "animframe.h"
+#include "arena.h"
 #include "brickout.h" // 推測：遊戲主標頭檔或共用定義
+#include "event.h"
+#include "multiball.h"
 #include "raylib.h"
-#include "raymath.h"
+#include "real.h" // 模擬用純量 (float 或定點數)
+#include "render.h"
+#include "script.h"
+#include "spritemask.h"
+#include "statehash.h"
+#include "sweep.h"
 #include "timer.h" // 提供 gTimer 的標頭檔
-#include <math.h> // 因 cosf, sinf (PI 預期在 raymath.h 中定義)
-#include <stdint.h> // 因 int16_t
+#include "world.h"
+#include <stdint.h> // 因 uint8_t, uint16_t
 #include <stdio.h> // 因 printf (DEBUG 時)
+#include <string.h>
 
 // ----------------------------------------------------------------------------------
 // 定義 (原程式碼中沒有，但有助於閱讀或視需要調整的項目)
 // ----------------------------------------------------------------------------------
-#define MAX_POINTS 72 // 組成路徑的最大點數
-#define MAX_ENEMYS 100 // 假設值，原程式碼應有定義
-#define REACH_THRESH 5.0f
-
-enum EnemyType {
-    ENEMY_NONE = 0,
-    ENEMY_FLY,
-    ENEMY_BUG,
-    ENEMY_SHIT,
-    ENEMY_CAKE,
-    ENEMY_NUMS,
-};
+#define ENEMY_FRAME_TICKS TIMER_SECONDS(0.16f) // 每個動畫影格的持續 tick 數 (約6FPS動畫)
+#define BATCH_ARC_SPACING R(48.0f) // 同一批敵人在路徑上的間距 (弧長)
 
 enum SpriteType {
     SPRITE_NONE = 0,
@@ -37,140 +36,120 @@ enum SpriteType {
 // ----------------------------------------------------------------------------------
 // 敵人路徑相關
 // ----------------------------------------------------------------------------------
-typedef struct {
-    Vector2 points[MAX_POINTS]; // 組成路徑的點陣列
-    int pointCount; // 路徑中的點數量
-} EnemyPath;
-
-EnemyPath enemyPath[5] = { 0 }; // 最多5種敵人路徑
+#define PATHTABLE_IMPLEMENTATION // 路徑表只在此編譯單元定義
+#include "pathtable.h"
 
 /**
- * @brief 根據指定參數產生路徑座標點
+ * @brief 路徑上弧長 s 處的位置
+ * 以二分搜尋累積弧長表找出線段，再沿線段切線內插，不需要開根號或三角函數。
  *
- * @param pointsOutput 儲存產生座標點的陣列
- * @param numPoints 要產生的點數量
- * @param scaleX X軸方向縮放比例
- * @param scaleY Y軸方向縮放比例
- * @param offsetX X軸方向偏移量 (中心X)
- * @param offsetY Y軸方向偏移量 (中心Y)
- * @param initialAngleValue 角度計算初始值
- * @param angleDecrementValue 每一步驟角度減少量
- * @param cosDiv cos計算時角度的除數 (對應原碼的90.0f或180.0f)
- * @param sinDiv sin計算時角度的除數 (對應原碼的360.0f或180.0f)
+ * @param path 路徑索引
+ * @param s 自起點的弧長 (超過一圈時取餘數)
+ * @param target 輸出：該位置之後的路徑點 (攤平索引)，可為 NULL
+ * @return 位置
  */
-static void CreatePathPoints(Vector2* pointsOutput, int numPoints, float scaleX, float scaleY, float offsetX, float offsetY, int initialAngleValue, int angleDecrementValue, float cosDiv, float sinDiv)
+RVec2 EnemyPathSample(int path, Real s, uint16_t* target)
 {
-    float x, y;
-    int angle = initialAngleValue; // 用於角度計算的變數
-    for (int i = 0; i < numPoints; i++) {
-        // 使用三角函數計算點的座標
-        x = scaleX * cosf((float)angle * PI / cosDiv);
-        y = scaleY * sinf((float)angle * PI / sinDiv);
-        pointsOutput[i].x = x + offsetX; // 加上偏移量得到最終座標
-        pointsOutput[i].y = y + offsetY;
-        angle -= angleDecrementValue; // 更新角度以供下一點使用
+    const EnemyPath* p = &enemyPath[path];
+    s = RWrap(s, p->arcLength[p->pointCount]);
+    int lo = 0, hi = p->pointCount - 1; // 找出 arcLength[lo] <= s 的最後一個線段
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (p->arcLength[mid] <= s) {
+            lo = mid;
+        } else {
+            hi = mid - 1;
+        }
     }
-}
-
-/**
- * @brief 初始化敵人移動路徑
- * 產生5種不同的路徑
- */
-static void EnemyPathInit()
-{
-    // 路徑0 (原程式碼的路徑)
-    CreatePathPoints(enemyPath[0].points, MAX_POINTS, 320.0f, 150.0f, 400.0f, 180.0f, 360 * 4, 20, 90.0f, 360.0f);
-    enemyPath[0].pointCount = MAX_POINTS;
-
-    // 路徑1 (近似圓形的軌道，較小，約在畫面左上角)
-    // 將縮放設為相同，cos/sin除數設為相同，可使軌道接近圓形。調整角度步進以完成一週。
-    // 範例：360度除以MAX_POINTS作為每步角度變化(度數)
-    // (float)(360 / MAX_POINTS) 作為 angleDecrementValue, initialAngleValue=0, cosDiv=180, sinDiv=180
-    CreatePathPoints(enemyPath[1].points, MAX_POINTS, 100.0f, 100.0f, 200.0f, 150.0f, 0, (int)(5 * (180.0f / PI)), 180.0f, 180.0f); // angleDecrementValue 可能需要調整 (此處5為範例，表示每步5個單位角度)
-    // 更簡單的範例：稍微修改原路徑參數
-    // CreatePathPoints(enemyPath[1].points, MAX_POINTS, 150.0f, 320.0f, 200.0f, 250.0f, 360 * 4, 20, 90.0f, 360.0f); // X/Y縮放反轉，偏移量變更
-    enemyPath[1].pointCount = MAX_POINTS;
-
-    // 路徑2 (長條橢圓形，畫面中央上部)
-    CreatePathPoints(enemyPath[2].points, MAX_POINTS, 300.0f, 100.0f, 400.0f, 120.0f, 0, 15, 180.0f, 180.0f);
-    enemyPath[2].pointCount = MAX_POINTS;
-
-    // 路徑3 (直立橢圓形，畫面右側)
-    CreatePathPoints(enemyPath[3].points, MAX_POINTS, 100.0f, 250.0f, 650.0f, 300.0f, 360 * 2, 25, 180.0f, 180.0f);
-    enemyPath[3].pointCount = MAX_POINTS;
-
-    // 路徑4 (稍微修改原路徑參數：起始角度、偏移量、縮放)
-    CreatePathPoints(enemyPath[4].points, MAX_POINTS, 250.0f, 120.0f, 400.0f, 450.0f, 0, 22, 120.0f, 270.0f);
-    enemyPath[4].pointCount = MAX_POINTS;
-
-    // 注意：上述路徑1至4的參數僅為範例。請根據期望的軌道進行調整。
-    // 特別是 angleDecrementValue 與 cosDiv/sinDiv 的組合會影響軌道的形狀及是否閉合。
+    if (target != NULL) {
+        *target = (uint16_t)(path * MAX_POINTS + (lo + 1 < p->pointCount ? lo + 1 : 0));
+    }
+    return RVec2Add(p->points[lo], RVec2Scale(p->tangent[lo], s - p->arcLength[lo]));
 }
 
 // ----------------------------------------------------------------------------------
 // 敵人實體相關
 // ----------------------------------------------------------------------------------
-typedef struct {
-    Vector2 pos[MAX_ENEMYS]; // 敵人目前位置
-    Vector2 dirVec[MAX_ENEMYS]; // 敵人目前移動方向向量 (已正規化)
-    int pathSelect[MAX_ENEMYS]; // 各敵人使用的路徑索引 (0-4)
-    int currPathCount[MAX_ENEMYS]; // 各敵人目前指向的路徑上點的索引
-    EnemyType eType[MAX_ENEMYS]; // 敵人種類
-    SpriteType sType[MAX_ENEMYS]; // 精靈種類 (動畫用)
-    float speed[MAX_ENEMYS]; // 敵人移動速度
-    float frameTime[MAX_ENEMYS]; // 動畫影格經過時間
-    int16_t frameCount[MAX_ENEMYS]; // 目前動畫影格編號
-    int count; // 目前活動中的敵人數量
-    AnimFrame af[ENEMY_NUMS - 1]; // 敵人精靈圖資訊 (所有敵人共用)
-} Enemys;
+_Static_assert(MAX_PATHS * MAX_POINTS <= UINT16_MAX, "target index must fit in uint16_t");
+_Static_assert(ENEMY_NUMS <= UINT8_MAX && MAX_PATHS <= UINT8_MAX, "enemy type and path must fit in uint8_t");
+
+static AnimFrame enemyAf[ENEMY_NUMS - 1]; // 敵人精靈圖資訊 (所有敵人共用，不屬於每個敵人的狀態)
+static SpriteMask enemyMask[ENEMY_NUMS - 1]; // 碰撞遮罩 (所有世界共用，無視窗時也會載入)
+
+// 精靈圖檔與單元格尺寸 (貼圖與碰撞遮罩共用)
+static const struct {
+    const char* fname;
+    int cellW, cellH;
+} enemySheet[ENEMY_NUMS - 1] = {
+    [ENEMY_FLY - 1] = { "asset/demon2.png", 64, 64 },
+    [ENEMY_BUG - 1] = { "asset/enemy-01.png", 48, 48 },
+    [ENEMY_SHIT - 1] = { "asset/enemy-02.png", 48, 48 },
+    [ENEMY_CAKE - 1] = { "asset/enemy-03.png", 48, 48 },
+};
+
+// 自生成以來經過的影格數 (未取模，繪製時才依精靈圖的單元格數取模)
+// 只使用 tick 與整數除法：碰撞遮罩的影格與幀間時間、浮點數運算無關，定點模式下重播結果相同。
+static inline int EnemyFrameCount(uint32_t now, uint32_t spawnTick)
+{
+    int32_t ticks = (int32_t)(now - spawnTick);
+    return ticks > 0 ? ticks / (int32_t)ENEMY_FRAME_TICKS : 0;
+}
+
+// 由生成的 tick 推算目前的動畫影格 (繪製與碰撞使用同一個影格)
+static inline int EnemyFrame(uint32_t now, uint32_t spawnTick, int frameCount)
+{
+    return EnemyFrameCount(now, spawnTick) % frameCount;
+}
 
-Enemys enemys = { 0 }; // 敵人管理結構的全域實體
 
 /**
- * @brief 使指定索引的敵人朝向路徑的下一個點
- *
- * @param index 目標敵人的索引
+ * @brief 載入敵人貼圖 (所有世界共用)
  */
-static void EnemySwitchNext(int index)
+void EnemyInit()
 {
-    enemys.currPathCount[index] += 1; // 前往下一個點
-    // 到達路徑終點後回到起點 (循環)
-    if (enemys.currPathCount[index] >= enemyPath[enemys.pathSelect[index]].pointCount) {
-        enemys.currPathCount[index] = 0;
+    for (int i = 0; i < ENEMY_NUMS - 1; i++) {
+        enemyAf[i] = AnimFrameLoad(enemySheet[i].fname, enemySheet[i].cellW, enemySheet[i].cellH); // 載入動畫影格資訊
+        AnimFrameTrack(&enemyAf[i]); // 素材熱重載時同步更新
     }
-    // 新的目標點
-    Vector2 target = enemyPath[enemys.pathSelect[index]].points[enemys.currPathCount[index]];
-    // 計算並正規化至新目標的方向向量
-    enemys.dirVec[index] = Vector2Normalize(Vector2Subtract(target, enemys.pos[index]));
 }
 
 /**
- * @brief 初始化敵人系統
+ * @brief 由精靈圖的 alpha 產生碰撞遮罩 (所有世界共用，建立世界之前呼叫一次)
+ * 只解碼圖片不上傳紋理，無視窗的批次執行也使用相同的遮罩；熱重載只替換貼圖，不改變遮罩 (重播結果不變)。
+ * 載入失敗時退回原本置中的 32x32 矩形。
  */
-void EnemyInit()
+void EnemyMaskInit()
 {
-    EnemyPathInit(); // 初始化敵人移動路徑
-    enemys.af[ENEMY_FLY - 1] = AnimFrameLoad("asset/demon2.png", 64, 64); // 載入動畫影格資訊
-    enemys.af[ENEMY_BUG - 1] = AnimFrameLoad("asset/enemy-01.png", 48, 48); // 載入動畫影格資訊
-    enemys.af[ENEMY_SHIT - 1] = AnimFrameLoad("asset/enemy-02.png", 48, 48); // 載入動畫影格資訊
-    enemys.af[ENEMY_CAKE - 1] = AnimFrameLoad("asset/enemy-03.png", 48, 48); // 載入動畫影格資訊
+    for (int i = 0; i < ENEMY_NUMS - 1; i++) {
+        if (!SpriteMaskLoad(&enemyMask[i], enemySheet[i].fname, enemySheet[i].cellW, enemySheet[i].cellH)) {
+            SpriteMaskBox(&enemyMask[i], enemySheet[i].cellW, enemySheet[i].cellH, 32, 32);
+        }
+    }
+}
 
+/**
+ * @brief 清空目前世界中的敵人 (產生由 wave.c 的時間軸負責)
+ */
+void EnemyReset()
+{
+    Enemys* enemys = &gWorld->enemys;
     for (int i = 0; i < MAX_ENEMYS; i++) {
-        enemys.pathSelect[i] = 0; // 預設路徑
-        enemys.currPathCount[i] = 0; // 從路徑起點開始
-        enemys.speed[i] = 200.0f; // 預設速度
-        enemys.eType[i] = ENEMY_NONE; // 初始狀態為非活動
+        enemys->cold.pathSelect[i] = 0; // 預設路徑
+        enemys->hot.target[i] = 1; // 初始目標點 (路徑0的第二個點) // 假設 pointCount > 1
+        enemys->cold.speed[i] = R(200.0f); // 預設速度
+        enemys->cold.eType[i] = ENEMY_NONE; // 初始狀態為非活動
         // 將初始位置設為路徑的起點
-        enemys.pos[i] = enemyPath[enemys.pathSelect[i]].points[0];
-        // 初始目標點 (路徑的第二個點) // 假設 pointCount > 1
-        Vector2 target = enemyPath[enemys.pathSelect[i]].points[1];
-        // 初始移動方向向量
-        enemys.dirVec[i] = Vector2Normalize(Vector2Subtract(target, enemys.pos[i]));
-        enemys.sType[i] = SPRITE_NONE; // 初始無精靈
-        enemys.frameTime[i] = 0; // 重設動畫時間
-        enemys.frameCount[i] = 0; // 重設動畫影格
+        enemys->hot.pos[i] = enemyPath[0].points[0];
+        // 初始速度向量
+        RVec2 dir = RVec2Normalize(RVec2Sub(EnemyPathPoint(enemys->hot.target[i]), enemys->hot.pos[i]));
+        enemys->hot.vel[i] = RVec2Scale(dir, enemys->cold.speed[i]);
+        enemys->hot.pc[i] = 0;
+        enemys->hot.counter[i] = 0;
+        enemys->cold.sType[i] = SPRITE_NONE; // 初始無精靈
+        enemys->cold.spawnTick[i] = 0; // 重設生成時間
     }
-    enemys.count = 0; // 活動中敵人數為0
+    enemys->count = 0; // 活動中敵人數為0
+    gWorld->enemySweep.count = 0;
 }
 
 /**
@@ -179,205 +158,311 @@ void EnemyInit()
 void EnemyFini()
 {
     for (int i = 0; i < ENEMY_NUMS - 1; i++) {
-        AnimFrameUnload(&enemys.af[enemys.eType[i]]); // 卸載已載入的動畫影格資訊
+        AnimFrameUnload(&enemyAf[i]); // 卸載已載入的動畫影格資訊
+    }
+}
+
+// 目前世界的敵人陣列 (腳本直譯器使用)
+static ScriptView EnemyScriptView()
+{
+    Enemys* enemys = &gWorld->enemys;
+    return (ScriptView) {
+        enemys->hot.pos, enemys->hot.vel, enemys->hot.target, enemys->hot.pc, enemys->hot.counter,
+        enemys->cold.speed, NULL, enemys->count
+    };
+}
+
+// 俯衝目標 (玩家板中心)
+static RVec2 EnemyDiveTarget()
+{
+    const RRect* paddle = &gWorld->player.rect;
+    return (RVec2) { paddle->x + paddle->width / 2, paddle->y };
+}
+
+// 追蹤腳本的目標：各敵人最近的球 (只在有使用追蹤腳本的敵人時查詢，結果放在每幀暫存配置器)
+static const RVec2* EnemyHomeTargets()
+{
+    Enemys* enemys = &gWorld->enemys;
+    bool homing = false;
+    for (int i = 0; i < enemys->count && !homing; i++) {
+        homing = ScriptHoming(ScriptForType((EnemyType)enemys->cold.eType[i]));
+    }
+    if (!homing) {
+        return NULL;
+    }
+    RVec2* home = FRAME_NEW(RVec2, enemys->count);
+    if (home != NULL) {
+        MultiballNearest(enemys->hot.pos, enemys->count, home);
     }
+    return home;
 }
 
 /**
- * @brief 嘗試產生新敵人
+ * @brief 推開互相重疊的敵人 (共用路徑的敵人會疊在一起，擋住彼此也看不出擊中)
+ * 以 x 軸的掃描與剪除找出重疊對，被推動的敵人重新瞄準目前的目標，才不會錯過路徑點。
+ */
+static void EnemySeparate(ScriptView view, RVec2 diveAt)
+{
+    EnemySweep* sweep = &gWorld->enemySweep;
+    SweepList list = { sweep->order, sweep->count };
+    SweepSort(&list, view.pos, view.count);
+    sweep->count = list.count;
+    memset(sweep->push, 0, sizeof(RVec2) * (size_t)view.count);
+    if (SweepPairs(&list, view.pos, ENEMY_SEPARATION, sweep->push, NULL) == 0) {
+        return;
+    }
+    SweepApply(view.pos, sweep->push, view.count, ENEMY_SEPARATION_RATE, ENEMY_SEPARATION_MAX_STEP);
+    for (int i = 0; i < view.count; i++) {
+        if (sweep->push[i].x != 0 || sweep->push[i].y != 0) {
+            ScriptAim(view, i, diveAt);
+        }
+    }
+}
+
+/**
+ * @brief 一次產生多個同種敵人 (連續寫入 SoA 陣列的末端)
+ * 同一批的敵人在起點之後沿路徑每隔 BATCH_ARC_SPACING 的弧長排開，形成等距的編隊而不是重疊在起點。
  *
  * @param eType 要新增的敵人種類
  * @param pathSel 使用的路徑索引
  * @param speed 敵人速度
+ * @param n 數量 (超過上限的部分被捨棄)
  */
-void EnemyTryAdd(EnemyType eType, int pathSel, float speed)
+void EnemyAddBatch(EnemyType eType, int pathSel, Real speed, int n)
 {
-    if (enemys.count >= MAX_ENEMYS) { // 檢查是否已達敵人最大數量
+    Enemys* enemys = &gWorld->enemys;
+    int room = MAX_ENEMYS - enemys->count;
+    if (n > room) { // 檢查是否已達敵人最大數量
 #ifdef DEBUG
-        printf("警告：已達到敵人數量上限。\n");
+        if (gWorld->debugLog) {
+            printf("警告：已達到敵人數量上限，捨棄 %d 個敵人。\n", n - room);
+        }
 #endif
-        return;
+        n = room;
+    }
+    uint32_t now = gTimer.Tick(); // 動畫從生成當下的第0格開始
+    for (int k = 0; k < n; k++) {
+        int i = enemys->count + k; // 新敵人的索引 (陣列末端新增)
+        enemys->cold.eType[i] = (uint8_t)eType;
+        enemys->cold.pathSelect[i] = (uint8_t)pathSel;
+        enemys->cold.speed[i] = speed;
+        enemys->hot.pos[i] = EnemyPathSample(pathSel, -k * BATCH_ARC_SPACING, &enemys->hot.target[i]); // 領隊在起點，其餘跟在後方
+        enemys->cold.sType[i] = SPRITE_FLY; // 假設設定為飛行型精靈
+        enemys->cold.spawnTick[i] = now;
+    }
+    enemys->count += n; // 增加活動中敵人數量
+    ScriptView view = EnemyScriptView();
+    RVec2 diveAt = EnemyDiveTarget();
+    ScriptId script = ScriptForType(eType);
+    for (int i = enemys->count - n; i < enemys->count; i++) {
+        ScriptStart(view, i, script, diveAt); // 設定初始速度
     }
-    int i = enemys.count; // 新敵人的索引 (陣列末端新增)
-    enemys.eType[i] = eType;
-    enemys.pathSelect[i] = pathSel;
-    enemys.currPathCount[i] = 1; // 初始目標為路徑的 points[1]
-    enemys.speed[i] = speed;
-    enemys.pos[i] = enemyPath[pathSel].points[0]; // 初始位置為路徑的 points[0]
-    Vector2 target = enemyPath[pathSel].points[1]; // 初始目標
-    enemys.dirVec[i] = Vector2Normalize(Vector2Subtract(target, enemys.pos[i]));
-    enemys.sType[i] = SPRITE_FLY; // 假設設定為飛行型精靈
-    enemys.frameTime[i] = 0;
-    enemys.frameCount[i] = 0;
-    enemys.count += 1; // 增加活動中敵人數量
 
 #ifdef DEBUG
-    printf("敵人數量：%d\n", enemys.count);
+    if (gWorld->debugLog && n > 0) {
+        printf("敵人數量：%d\n", enemys->count);
+    }
 #endif
 }
 
-/**
- * @brief 更新敵人狀態 (移動、動畫等)
- */
-void EnemyUpdate()
+// 移除標記為 ENEMY_NONE 的敵人 (一次壓縮走訪，保持其餘敵人的順序)
+static void EnemyCompact()
 {
-    float deltaTime = gTimer.DeltaTime(); // 取得自上一影格的經過時間
-    const float reachThreshSqr = REACH_THRESH * REACH_THRESH; // 到達判定的閾值 (平方值比較)
-
-    for (int i = 0; i < enemys.count; i++) {
-        if (enemys.eType[i] == ENEMY_NONE)
-            continue; // 跳過非活動的敵人
-
-        // 更新敵人位置 (目前位置 + 方向向量 * 速度 * 經過時間)
-        enemys.pos[i] = Vector2Add(enemys.pos[i], Vector2Scale(enemys.dirVec[i], enemys.speed[i] * deltaTime));
-
-        // 目前目標點
-        Vector2 target = enemyPath[enemys.pathSelect[i]].points[enemys.currPathCount[i]];
-        // 計算至目標的距離平方
-        float distSqr = Vector2DistanceSqr(enemys.pos[i], target);
-
-        // 若已足夠接近目標，則切換至下一個目標
-        if (distSqr < reachThreshSqr) {
-            EnemySwitchNext(i);
+    Enemys* enemys = &gWorld->enemys;
+    int w = 0;
+    for (int i = 0; i < enemys->count; i++) {
+        if (enemys->cold.eType[i] == ENEMY_NONE) {
+            continue;
         }
-
-        // 更新動畫影格
-        enemys.frameTime[i] += deltaTime;
-        if (enemys.frameTime[i] >= 0.16f) { // 每0.16秒更新一次影格 (約6FPS動畫)
-            enemys.frameTime[i] -= 0.16f;
-            enemys.frameCount[i] = (enemys.frameCount[i] + 1) % enemys.af[enemys.eType[i] - 1].xCellCount; // 循環動畫影格
+        if (w != i) {
+            enemys->hot.pos[w] = enemys->hot.pos[i];
+            enemys->hot.vel[w] = enemys->hot.vel[i];
+            enemys->hot.target[w] = enemys->hot.target[i];
+            enemys->hot.pc[w] = enemys->hot.pc[i];
+            enemys->hot.counter[w] = enemys->hot.counter[i];
+            enemys->cold.eType[w] = enemys->cold.eType[i];
+            enemys->cold.sType[w] = enemys->cold.sType[i];
+            enemys->cold.pathSelect[w] = enemys->cold.pathSelect[i];
+            enemys->cold.speed[w] = enemys->cold.speed[i];
+            enemys->cold.spawnTick[w] = enemys->cold.spawnTick[i];
+            enemys->cold.eType[i] = ENEMY_NONE;
         }
+        w++;
     }
+    enemys->count = w;
 }
 
-/**
- * @brief 移除指定索引的敵人
- *
- * @param index 要移除的敵人索引
- */
-void EnemyRemove(int index)
+// 移除離開畫面 (超出 ENEMY_CULL_MARGIN) 的敵人；在偵測階段之前呼叫，本 tick 的擊中事件索引不受影響
+static void EnemyCull()
 {
-    // 索引有效性檢查
-    if (index < 0 || index >= enemys.count) {
-#ifdef DEBUG
-        printf("警告：無效的敵人移除索引 %d。\n", index);
-#endif
-        return;
+    Enemys* enemys = &gWorld->enemys;
+    int culled = 0;
+    for (int i = 0; i < enemys->count; i++) {
+        RVec2 p = enemys->hot.pos[i];
+        if (p.x < -ENEMY_CULL_MARGIN || p.x > R(SCR_WIDTH) + ENEMY_CULL_MARGIN || p.y < -ENEMY_CULL_MARGIN || p.y > R(SCR_HEIGHT) + ENEMY_CULL_MARGIN) {
+            enemys->cold.eType[i] = ENEMY_NONE;
+            culled++;
+        }
     }
-    // 若已為非活動則不進行任何操作
-    if (enemys.eType[index] == ENEMY_NONE) {
+    if (culled > 0) {
+        EnemyCompact();
 #ifdef DEBUG
-        printf("警告：索引 %d 的敵人已為非活動狀態。\n", index);
+        if (gWorld->debugLog) {
+            printf("警告：%d 個敵人離開畫面，已移除。新的敵人數量：%d\n", culled, enemys->count);
+        }
 #endif
-        return;
     }
+}
 
-    // 若被移除的元素不是陣列最後一個，則將最後一個元素移至該位置以填補空缺
-    if (index < enemys.count - 1) {
-        enemys.currPathCount[index] = enemys.currPathCount[enemys.count - 1];
-        enemys.pathSelect[index] = enemys.pathSelect[enemys.count - 1];
-        enemys.dirVec[index] = enemys.dirVec[enemys.count - 1];
-        enemys.speed[index] = enemys.speed[enemys.count - 1];
-        enemys.pos[index] = enemys.pos[enemys.count - 1];
-        enemys.eType[index] = enemys.eType[enemys.count - 1];
-        enemys.sType[index] = enemys.sType[enemys.count - 1];
-        enemys.frameTime[index] = enemys.frameTime[enemys.count - 1];
-        enemys.frameCount[index] = enemys.frameCount[enemys.count - 1];
-    }
-    // 將陣列最後一個元素（或被移動的原始元素）設為非活動
-    enemys.eType[enemys.count - 1] = ENEMY_NONE;
-    enemys.count -= 1; // 減少活動中敵人數量
+/**
+ * @brief 更新敵人狀態 (移動並恢復每個敵人的行為腳本，移除離開畫面的敵人)
+ */
+void EnemyUpdate()
+{
+    ScriptView view = EnemyScriptView();
+    RVec2 diveAt = EnemyDiveTarget();
+    view.homeAt = EnemyHomeTargets();
+    ScriptRun(view, RDeltaTime(), diveAt);
+    EnemyCull();
+    view.count = gWorld->enemys.count;
+    EnemySeparate(view, diveAt);
+}
 
+/**
+ * @brief 批次處理本幀事件
+ * 先標記所有被擊中的敵人，以一次壓縮走訪移除 (保持其餘敵人的順序)，再處理產生事件。
+ * 擊中事件中的索引在本幀偵測階段取得，因此必須在任何新增/移除之前處理。
+ */
+void EnemyHandleEvents()
+{
+    Enemys* enemys = &gWorld->enemys;
+    int removed = 0;
+    for (int i = 0; i < EventCount(); i++) {
+        const GameEvent* ev = EventGet(i);
+        if (ev->type != EVENT_HIT) {
+            continue;
+        }
+        int index = ev->hit.index;
+        if (index >= 0 && index < enemys->count && enemys->cold.eType[index] != ENEMY_NONE) {
+            enemys->cold.eType[index] = ENEMY_NONE;
+            removed++;
+        }
+    }
+    if (removed > 0) {
+        EnemyCompact();
 #ifdef DEBUG
-    printf("已從索引 %d 移除敵人。新的敵人數量：%d\n", index, enemys.count);
+        if (gWorld->debugLog) {
+            printf("已移除 %d 個敵人。新的敵人數量：%d\n", removed, enemys->count);
+        }
 #endif
+    }
+    for (int i = 0; i < EventCount(); i++) {
+        const GameEvent* ev = EventGet(i);
+        if (ev->type == EVENT_SPAWN) {
+            EnemyAddBatch(ev->spawn.eType, ev->spawn.path, ev->spawn.speed, ev->spawn.count);
+        }
+    }
 }
 
 /**
- * @brief 繪製敵人
+ * @brief 將敵人加入繪製清單 (以位置為中心)
  */
-void EnemyDraw()
+void EnemyRender(RenderFrame* f)
 {
-    for (int i = 0; i < enemys.count; i++) {
-        if (enemys.eType[i] == ENEMY_NONE)
+    Enemys* enemys = &gWorld->enemys;
+    uint32_t now = gTimer.Tick();
+    for (int i = 0; i < enemys->count; i++) {
+        if (enemys->cold.eType[i] == ENEMY_NONE)
             continue; // 不繪製非活動的敵人
+        // 由生成時間推算動畫影格 (假設僅有水平方向動畫)，與更新頻率無關
+        RenderPushSprite(f, &enemyAf[enemys->cold.eType[i] - 1], enemys->hot.pos[i], EnemyFrameCount(now, enemys->cold.spawnTick[i]), RENDER_CELL);
+    }
+}
 
-        // 計算動畫影格 (假設僅有水平方向動畫)
-        int frame_col = enemys.frameCount[i] % enemys.af[enemys.eType[i] - 1].xCellCount;
-        int frame_row = 0; // Y方向的儲存格固定為第0列 (若需依sType等變更則調整)
-
-        // 來源精靈圖上的繪製矩形區域
-        Rectangle sourceRec = {
-            (float)(frame_col * enemys.af[enemys.eType[i]-1].cellW), // 影格欄 * 儲存格寬度
-            (float)(frame_row * enemys.af[enemys.eType[i]-1].cellH), // 影格列 * 儲存格高度
-            (float)enemys.af[enemys.eType[i]-1].cellW,
-            (float)enemys.af[enemys.eType[i]-1].cellH
-        };
-        // 目標畫面上繪製矩形區域 (位置為敵人中心，大小為儲存格大小)
-        Rectangle destRec = {
-            enemys.pos[i].x, // 繪製位置 X (中心)
-            enemys.pos[i].y, // 繪製位置 Y (中心)
-            (float)enemys.af[enemys.eType[i]-1].cellW,
-            (float)enemys.af[enemys.eType[i]-1].cellH
-        };
-        // 旋轉軸心 (精靈中心)
-        Vector2 origin = { (float)enemys.af[enemys.eType[i]-1].centerW, (float)enemys.af[enemys.eType[i]-1].centerH };
-
-        // 繪製紋理
-        DrawTexturePro(enemys.af[enemys.eType[i]-1].tex, sourceRec, destRec, origin, 0.0f, WHITE);
+/**
+ * @brief 敵人 i 目前的動畫影格與遮罩是否有重疊的實心像素
+ * 先以單元格矩形做粗略判定，重疊時再以遮罩做位移 AND (每列一次字運算)。
+ *
+ * @param i 敵人索引
+ * @param mask 碰撞遮罩 (使用第 0 個影格)
+ * @param mx 遮罩左上角的像素 X 座標
+ * @param my 遮罩左上角的像素 Y 座標
+ * @return true 若重疊
+ */
+bool EnemyOverlap(int i, const SpriteMask* mask, int mx, int my)
+{
+    Enemys* enemys = &gWorld->enemys;
+    const SpriteMask* em = &enemyMask[enemys->cold.eType[i] - 1];
+    // 敵人位置指向精靈的中心 (與 EnemyDraw 的繪製原點相同)
+    int ex = RFloorInt(enemys->hot.pos[i].x) - em->centerW;
+    int ey = RFloorInt(enemys->hot.pos[i].y) - em->centerH;
+    if (mx >= ex + em->cellW || ex >= mx + mask->cellW || my >= ey + em->cellH || ey >= my + mask->cellH) {
+        return false; // 單元格矩形不重疊
     }
+    const SpriteMaskFrame* frame = &em->frames[EnemyFrame(gTimer.Tick(), enemys->cold.spawnTick[i], em->frameCount)];
+    return SpriteMaskOverlap(frame, ex, ey, &mask->frames[0], mx, my);
 }
 
 /**
- * @brief 執行指定圓形與敵人之間的碰撞偵測
+ * @brief 執行指定遮罩與敵人之間的像素精確碰撞偵測
  *
- * @param ballCenterPos 圓心座標
- * @param ballRadius 圓半徑
+ * @param center 遮罩中心座標 (例如球心)
+ * @param mask 碰撞遮罩 (使用第 0 個影格)
  * @param index 若發生碰撞，儲存碰撞敵人索引的指標
  * @return true 若發生碰撞
  * @return false 若未發生碰撞
  */
-bool EnemyCollision(Vector2 ballCenterPos, float ballRadius, int* index)
+bool EnemyCollision(RVec2 center, const SpriteMask* mask, int* index)
 {
-    for (int i = 0; i < enemys.count; i++) {
-        if (enemys.eType[i] == ENEMY_NONE) continue; // 不對非活動的敵人進行偵測
-
-        // 定義敵人碰撞偵測用的矩形
-        // 敵人位置 (enemys.pos[i]) 指向精靈的中心
-        // 將 32x32 的矩形設定於中心位置
-        // 左上X = 中心X - 寬度/2 = enemys.pos[i].x - 16
-        // 左上Y = 中心Y - 高度/2 = enemys.pos[i].y - 16
-        Rectangle enemyRect = {
-            enemys.pos[i].x - 16.0f, // 修正點：原程式碼 enemys.pos[i].x + 16 位置錯誤
-            enemys.pos[i].y - 16.0f, // 修正點：原程式碼 enemys.pos[i].y + 16 位置錯誤
-            32.0f,                   // 寬度
-            32.0f                    // 高度
-        };
-
-        // 圓形與矩形的碰撞偵測
-        if (CheckCollisionCircleRec(ballCenterPos, ballRadius, enemyRect)) {
-            *index = i;    // 儲存碰撞敵人的索引
+    Enemys* enemys = &gWorld->enemys;
+    int mx = RFloorInt(center.x) - mask->centerW; // 遮罩左上角的像素座標
+    int my = RFloorInt(center.y) - mask->centerH;
+    for (int i = 0; i < enemys->count; i++) {
+        if (EnemyOverlap(i, mask, mx, my)) {
+            *index = i; // 儲存碰撞敵人的索引
             return true; // 偵測到碰撞
         }
     }
     return false; // 無碰撞
 }
 
-// ----------------------------------------------------------------------------------
-// 敵人產生相關
-// ----------------------------------------------------------------------------------
-static float spawnTime = 0.0f; // 自上次產生後的經過時間
+/**
+ * @brief 敵人的實心外框 (所有動畫影格的聯集，與 EnemyCollision 使用相同的像素座標)
+ *
+ * @param i 敵人索引
+ * @return 外框矩形
+ */
+RRect EnemyBounds(int i)
+{
+    const Enemys* enemys = &gWorld->enemys;
+    const SpriteMask* em = &enemyMask[enemys->cold.eType[i] - 1];
+    int x = RFloorInt(enemys->hot.pos[i].x) - em->centerW + em->minX;
+    int y = RFloorInt(enemys->hot.pos[i].y) - em->centerH + em->minY;
+    return (RRect) { RFromInt(x), RFromInt(y), RFromInt(em->maxX - em->minX + 1), RFromInt(em->maxY - em->minY + 1) };
+}
 
 /**
- * @brief 隨時間經過產生敵人
+ * @brief 敵人的模擬狀態 (快照用)
+ * enemyPath 在初始化後不再改變，因此不需保存。
  */
-void EnemySpawn()
+StateBlock EnemyStateBlock()
 {
-    spawnTime += gTimer.DeltaTime(); // 累加經過時間
-    if (spawnTime > 1.0f) { // 每2秒產生一個新敵人
-        // 新增 ENEMY_FLY 類型敵人，使用隨機路徑 (0-4)，速度200
-        int enemyRand = GetRandomValue(1,4);
-        EnemyTryAdd(enemyRand, GetRandomValue(0, 4), 200.0f);
-        spawnTime = 0.0f; // 重設產生計時器
-    }
-}
\ No newline at end of file
+    return (StateBlock) { &gWorld->enemys, sizeof(Enemys) };
+}
+
+/**
+ * @brief 將活動中敵人的位置/速度/路徑索引累加進雜湊值
+ * 熱資料陣列是連續的，每個陣列只需一次累加。
+ */
+uint64_t EnemyStateHash(uint64_t h)
+{
+    Enemys* enemys = &gWorld->enemys;
+    size_t n = (size_t)enemys->count;
+    h = StateHashBytes(h, &enemys->count, sizeof(enemys->count));
+    h = StateHashBytes(h, enemys->hot.pos, sizeof(RVec2) * n);
+    h = StateHashBytes(h, enemys->hot.vel, sizeof(RVec2) * n);
+    h = StateHashBytes(h, enemys->hot.target, sizeof(uint16_t) * n);
+    h = StateHashBytes(h, enemys->hot.pc, n);
+    h = StateHashBytes(h, enemys->hot.counter, sizeof(uint16_t) * n);
+    return StateHashBytes(h, enemys->cold.spawnTick, sizeof(uint32_t) * n); // 決定碰撞遮罩的影格
+}
@@ -1,18 +1,106 @@
 #ifndef __ENEMY_H__
 #define __ENEMY_H__
 #include "brickout.h"
+#include "pathtable.h"
+#include "real.h"
+#include "snapshot.h"
+#include "spritemask.h"
+#include <stdint.h>
 
-typedef enum EnemyType EnemyType;
+typedef struct RenderFrame RenderFrame; // render.h
+
+#define CACHE_LINE 64 // 快取行大小 (位元組)，SoA 陣列以此對齊
+#define MAX_ENEMYS 100 // 每個世界的敵人數量上限
+#define MAX_PATHS PATH_COUNT // 路徑數量 (路徑表由 tools/pathgen.c 產生)
+#define MAX_POINTS PATH_MAX_POINTS // 組成路徑的最大點數
+#define REACH_THRESH_PX 5.0f // 到達路徑點的判定距離 (像素)
+#define REACH_THRESH R(REACH_THRESH_PX)
+#define ENEMY_SEPARATION R(32.0f) // 敵人中心之間的最小距離 (小於此距離時互相推開)
+#define ENEMY_SEPARATION_RATE R(0.25f) // 每個 tick 推開重疊量的比例
+#define ENEMY_CULL_MARGIN R(128.0f) // 超出畫面邊緣此距離的敵人被移除 (腳本異常也不會永久佔用欄位)
+#define ENEMY_SEPARATION_MAX_STEP R(1.0f) // 每個 tick 被推開的上限 (像素，遠小於移動量，擠向同一路徑點的敵人仍能到達)
+
+typedef enum EnemyType {
+    ENEMY_NONE = 0,
+    ENEMY_FLY,
+    ENEMY_BUG,
+    ENEMY_SHIT,
+    ENEMY_CAKE,
+    ENEMY_NUMS,
+} EnemyType;
 
 typedef enum SpriteType SpriteType;
 
-void EnemyInit();
+// 敵人路徑 (建置時產生的唯讀表，所有世界與行程共用)
+typedef struct {
+    RVec2 points[MAX_POINTS]; // 組成路徑的點陣列
+    RVec2 tangent[MAX_POINTS]; // 線段 i → i+1 的單位方向 (最後一段回到起點)
+    Real arcLength[MAX_POINTS + 1]; // 起點到點 i 的弧長，arcLength[pointCount] 為一圈的長度
+    int pointCount; // 路徑中的點數量
+} EnemyPath;
+
+extern const EnemyPath enemyPath[MAX_PATHS];
+
+// 取得攤平索引 (路徑 * MAX_POINTS + 點) 對應的路徑點
+static inline RVec2 EnemyPathPoint(uint16_t target)
+{
+    return enemyPath[target / MAX_POINTS].points[target % MAX_POINTS];
+}
+
+// 同一路徑的下一個點 (到達終點後回到起點)
+static inline uint16_t EnemyPathNext(uint16_t target)
+{
+    int path = target / MAX_POINTS;
+    int point = target % MAX_POINTS + 1;
+    return (uint16_t)(path * MAX_POINTS + (point < enemyPath[path].pointCount ? point : 0));
+}
+
+// 熱資料：EnemyUpdate 每個 tick 對每個敵人都會讀寫
+typedef struct {
+    _Alignas(CACHE_LINE) RVec2 pos[MAX_ENEMYS]; // 敵人目前位置
+    _Alignas(CACHE_LINE) RVec2 vel[MAX_ENEMYS]; // 敵人目前速度向量 (方向 * 速度)
+    _Alignas(CACHE_LINE) uint16_t target[MAX_ENEMYS]; // 目標點在路徑表中的攤平索引 (路徑 * MAX_POINTS + 點)
+    _Alignas(CACHE_LINE) uint8_t pc[MAX_ENEMYS]; // 行為腳本的程式計數器 (script.c)
+    _Alignas(CACHE_LINE) uint16_t counter[MAX_ENEMYS]; // 目前指令的計數器 (剩餘路徑點或等待 tick)
+} EnemyHot;
+
+// 冷資料：只在生成、切換目標點、繪製時使用
+typedef struct {
+    _Alignas(CACHE_LINE) uint8_t eType[MAX_ENEMYS]; // 敵人種類 (EnemyType)
+    _Alignas(CACHE_LINE) uint8_t sType[MAX_ENEMYS]; // 精靈種類 (SpriteType，動畫用)
+    _Alignas(CACHE_LINE) uint8_t pathSelect[MAX_ENEMYS]; // 各敵人使用的路徑索引 (0-4)
+    _Alignas(CACHE_LINE) Real speed[MAX_ENEMYS]; // 敵人移動速度
+    _Alignas(CACHE_LINE) uint32_t spawnTick[MAX_ENEMYS]; // 生成時的 tick (動畫與碰撞遮罩的影格由此推算)
+} EnemyCold;
+
+// 敵人管理結構 (屬於 GameWorld 的模擬狀態)
+typedef struct {
+    EnemyHot hot;
+    EnemyCold cold;
+    int count; // 目前活動中的敵人數量，[0, count) 內的敵人皆為活動中
+} Enemys;
+
+// 敵人分離用的 x 軸順序 (屬於 GameWorld 但不是模擬狀態，快照不保存)
+// 跨 tick 保留以利用幀間的連貫性；排序結果與保留的順序無關，還原快照後不必重建。
+typedef struct {
+    uint32_t order[MAX_ENEMYS]; // 依 x 排序的敵人索引 (sweep.c)
+    RVec2 push[MAX_ENEMYS]; // 本 tick 累加的推開量
+    int count; // 上次排序時的敵人數
+} EnemySweep;
+
+RVec2 EnemyPathSample(int path, Real s, uint16_t* target); // 路徑上弧長 s 處的位置 (等速移動、編隊間距用)
+void EnemyInit(); // 載入敵人貼圖
+void EnemyMaskInit(); // 產生敵人的碰撞遮罩 (建立世界之前呼叫一次)
+void EnemyReset(); // 清空目前世界中的敵人
 void EnemyFini();
-void EnemyTryAdd(EnemyType eType, int pathSel, float speed);
+void EnemyAddBatch(EnemyType eType, int pathSel, Real speed, int n); // 一次產生 n 個同種敵人
 void EnemyUpdate();
-void EnemyDraw();
-bool EnemyCollision(Vec2 ballCenterPos, float ballRadius, int* index);
-void EnemyRemove(int index);
-void EnemySpawn();
+void EnemyRender(RenderFrame* f); // 將敵人加入繪製清單
+bool EnemyOverlap(int i, const SpriteMask* mask, int mx, int my); // 敵人 i 與遮罩 (左上角位於像素 (mx, my)) 是否重疊
+bool EnemyCollision(RVec2 center, const SpriteMask* mask, int* index); // 像素精確碰撞 (遮罩中心位於 center)
+RRect EnemyBounds(int i); // 敵人的實心外框 (射線查詢用)
+void EnemyHandleEvents();
+StateBlock EnemyStateBlock(); // 敵人的模擬狀態 (快照用)
+uint64_t EnemyStateHash(uint64_t h); // 將活動中敵人的位置/速度/路徑索引累加進雜湊值
 
 #endif
\ No newline at end of file
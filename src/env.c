@@ -0,0 +1,179 @@
+#include "env.h"
+#include "arena.h"
+#include "event.h"
+#include "player.h"
+#include "real.h"
+#include "world.h"
+#include <stdlib.h>
+
+#define ENV_STEP (1.0f / 60.0f) // 每個 tick 的固定秒數
+
+struct Env {
+    void* raw; // worlds 的原始配置 (對齊前)
+    GameWorld* worlds;
+    int32_t* prevScore; // 上一個 tick 結束時的分數 (計算獎勵用)
+    uint8_t* lost; // 本 tick 是否發生球掉落 (由事件監聽函數設定)
+    uint32_t* episode; // 各環境已開始的回合數 (自動重設時衍生種子)
+    uint32_t seed;
+    int n;
+};
+
+// 事件監聽函數：記錄球掉落 (佇列在 tick 結尾清除，因此在寫入時記錄)
+static void EnvEventTap(const GameEvent* ev, void* user)
+{
+    if (ev->type == EVENT_BALL_LOST) {
+        *(uint8_t*)user = 1;
+    }
+}
+
+// 由基礎種子、環境索引與回合數衍生種子 (splitmix32)
+static uint32_t EnvSeed(uint32_t seed, int index, uint32_t episode)
+{
+    uint32_t x = seed + (uint32_t)index * 0x9e3779b9u + episode * 0x85ebca6bu;
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+// 重設第 i 個環境並開始新的回合 (會綁定該世界)
+static void EnvResetOne(Env* env, int i)
+{
+    WorldInit(&env->worlds[i], EnvSeed(env->seed, i, env->episode[i]++), ENV_STEP);
+    EventSetTap(EnvEventTap, &env->lost[i]); // EventInit 會移除監聽函數，每次重設後重新設定
+    env->prevScore[i] = PlayerScore();
+    env->lost[i] = 0;
+}
+
+// 將目前世界的觀測值寫入 out (ENV_OBS_SIZE 個 float)
+static void EnvObserve(float* out)
+{
+    const GameWorld* w = gWorld;
+    out[0] = RToFloat(w->ball.pos.x) / SCR_WIDTH;
+    out[1] = RToFloat(w->ball.pos.y) / SCR_HEIGHT;
+    out[2] = RToFloat(w->ball.acceleration.x);
+    out[3] = RToFloat(w->ball.acceleration.y);
+    out[4] = RToFloat(w->player.rect.x + w->player.rect.width / 2) / SCR_WIDTH;
+    // 以插入排序保留距離球最近的 K 個敵人 (K 很小，O(count * K))
+    RealWide best[ENV_NEAREST_ENEMIES];
+    int bestIndex[ENV_NEAREST_ENEMIES];
+    int found = 0;
+    for (int i = 0; i < w->enemys.count; i++) {
+        RealWide d = RVec2DistanceSqr(w->enemys.hot.pos[i], w->ball.pos);
+        if (found == ENV_NEAREST_ENEMIES && d >= best[found - 1]) {
+            continue;
+        }
+        int k = found < ENV_NEAREST_ENEMIES ? found++ : found - 1;
+        while (k > 0 && best[k - 1] > d) {
+            best[k] = best[k - 1];
+            bestIndex[k] = bestIndex[k - 1];
+            k--;
+        }
+        best[k] = d;
+        bestIndex[k] = i;
+    }
+    for (int k = 0; k < ENV_NEAREST_ENEMIES; k++) {
+        if (k < found) {
+            RVec2 p = w->enemys.hot.pos[bestIndex[k]];
+            out[5 + 2 * k] = RToFloat(p.x) / SCR_WIDTH;
+            out[6 + 2 * k] = RToFloat(p.y) / SCR_HEIGHT;
+        } else {
+            out[5 + 2 * k] = -1.0f;
+            out[6 + 2 * k] = -1.0f;
+        }
+    }
+}
+
+/**
+ * @brief 建立 n 個環境 (唯一會配置記憶體的函數)
+ */
+Env* EnvCreate(int n)
+{
+    if (n <= 0) {
+        return NULL;
+    }
+    Env* env = calloc(1, sizeof(Env));
+    if (env == NULL) {
+        return NULL;
+    }
+    size_t align = _Alignof(GameWorld);
+    env->raw = malloc(sizeof(GameWorld) * (size_t)n + align);
+    env->prevScore = calloc((size_t)n, sizeof(int32_t));
+    env->lost = calloc((size_t)n, sizeof(uint8_t));
+    env->episode = calloc((size_t)n, sizeof(uint32_t));
+    if (env->raw == NULL || env->prevScore == NULL || env->lost == NULL || env->episode == NULL) {
+        EnvDestroy(env);
+        return NULL;
+    }
+    env->worlds = (GameWorld*)(((uintptr_t)env->raw + align - 1) & ~(uintptr_t)(align - 1));
+    env->n = n;
+    GameWorld* prev = gWorld;
+    for (int i = 0; i < n; i++) {
+        EnvResetOne(env, i);
+    }
+    WorldBind(prev);
+    return env;
+}
+
+void EnvDestroy(Env* env)
+{
+    if (env == NULL) {
+        return;
+    }
+    free(env->raw);
+    free(env->prevScore);
+    free(env->lost);
+    free(env->episode);
+    free(env);
+}
+
+int EnvCount(const Env* env)
+{
+    return env->n;
+}
+
+/**
+ * @brief 以 seed 重設全部環境並寫入初始觀測
+ * 相同的 seed 與動作序列會產生完全相同的結果。
+ */
+void EnvReset(Env* env, uint32_t seed, float* obs)
+{
+    GameWorld* prev = gWorld;
+    env->seed = seed;
+    for (int i = 0; i < env->n; i++) {
+        env->episode[i] = 0;
+        EnvResetOne(env, i);
+        EnvObserve(obs + (size_t)i * ENV_OBS_SIZE);
+    }
+    WorldBind(prev);
+}
+
+/**
+ * @brief 以鎖步推進全部環境一個 tick
+ */
+void EnvStep(Env* env, const uint8_t* actions, float* obs, float* rewards, uint8_t* dones)
+{
+    GameWorld* prev = gWorld;
+    for (int i = 0; i < env->n; i++) {
+        GameWorld* w = &env->worlds[i];
+        WorldBind(w);
+        w->input.left = actions[i] == ENV_ACTION_LEFT;
+        w->input.right = actions[i] == ENV_ACTION_RIGHT;
+        FrameArenaSwap(); // 子系統的每幀暫存資料只在本 tick 內使用
+        WorldStep();
+        if (env->lost[i]) {
+            rewards[i] = -1.0f;
+            dones[i] = 1;
+            EnvResetOne(env, i);
+        } else {
+            int32_t score = PlayerScore();
+            rewards[i] = (float)(score - env->prevScore[i]) / HIT_SCORE;
+            dones[i] = 0;
+            env->prevScore[i] = score;
+        }
+        EnvObserve(obs + (size_t)i * ENV_OBS_SIZE);
+    }
+    WorldBind(prev);
+}
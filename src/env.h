@@ -0,0 +1,35 @@
+#ifndef __ENV_H__
+#define __ENV_H__
+#include <stdint.h>
+
+// 強化學習用的向量化環境
+// 一個 Env 以鎖步推進 n 個獨立的 GameWorld (固定 1/60 秒步長，不繪圖)。
+// 觀測值、獎勵與結束旗標直接寫入呼叫端提供的連續緩衝區，EnvCreate 之後不再配置記憶體。
+// 每個 Env 只能同時由一個執行緒使用；多核心時每個執行緒各建立一個 Env。
+// EnvStep 會切換呼叫執行緒的每幀暫存配置器，不應在繪製互動遊戲的執行緒上呼叫。
+
+#define ENV_NEAREST_ENEMIES 4 // 觀測中包含距離球最近的敵人數量 (K)
+#define ENV_OBS_SIZE (5 + 2 * ENV_NEAREST_ENEMIES) // 每個環境的觀測值數量
+
+// 觀測值排列 (每個環境 ENV_OBS_SIZE 個 float，座標以畫面尺寸正規化為 0~1)：
+// [0] 球 x  [1] 球 y  [2] 球方向 x  [3] 球方向 y  [4] 玩家板中心 x
+// [5 + 2k] [6 + 2k] 第 k 近的敵人 x, y (由近到遠，不足 K 個時填 -1)
+
+typedef enum EnvAction {
+    ENV_ACTION_STAY = 0, // 不動
+    ENV_ACTION_LEFT, // 左移
+    ENV_ACTION_RIGHT, // 右移
+} EnvAction;
+
+typedef struct Env Env;
+
+Env* EnvCreate(int n); // 建立 n 個環境，失敗時返回 NULL
+void EnvDestroy(Env* env);
+int EnvCount(const Env* env); // 環境數量
+void EnvReset(Env* env, uint32_t seed, float* obs); // 重設全部環境並寫入初始觀測 (n * ENV_OBS_SIZE)
+// 每個環境執行 actions[i] 一個 tick，寫入觀測 (n * ENV_OBS_SIZE)、獎勵 (n) 與結束旗標 (n)
+// 獎勵為本 tick 的得分增量 (每擊中一個敵人 +1)，球掉落時為 -1 並設定結束旗標；
+// 結束的環境會自動重設，obs 中寫入的是新回合的初始觀測。
+void EnvStep(Env* env, const uint8_t* actions, float* obs, float* rewards, uint8_t* dones);
+
+#endif
@@ -0,0 +1,78 @@
+#include "event.h"
+#include "world.h"
+#include <stdio.h>
+
+#define EVENT_MASK (MAX_EVENTS - 1)
+
+_Static_assert((MAX_EVENTS & EVENT_MASK) == 0, "MAX_EVENTS must be a power of two");
+
+/**
+ * @brief 清空事件佇列並移除監聽函數
+ */
+void EventInit()
+{
+    EventQueue* events = &gWorld->events;
+    events->head = 0;
+    events->count = 0;
+    events->tap = NULL;
+    events->tapUser = NULL;
+}
+
+/**
+ * @brief 寫入一個事件
+ * 佇列已滿時捨棄事件 (每幀事件數量遠小於容量)。
+ */
+void EventPush(GameEvent ev)
+{
+    EventQueue* events = &gWorld->events;
+    if (events->count >= MAX_EVENTS) {
+#ifdef DEBUG
+        printf("Warning: Event queue is full, event %d dropped.\n", ev.type);
+#endif
+        return;
+    }
+    GameEvent* slot = &events->ring[(events->head + events->count) & EVENT_MASK];
+    *slot = ev;
+    events->count++;
+    if (events->tap != NULL) {
+        events->tap(slot, events->tapUser);
+    }
+}
+
+/**
+ * @brief 本幀尚未清除的事件數量
+ */
+int EventCount()
+{
+    return (int)gWorld->events.count;
+}
+
+/**
+ * @brief 取得本幀第 i 個事件
+ */
+const GameEvent* EventGet(int i)
+{
+    EventQueue* events = &gWorld->events;
+    return &events->ring[(events->head + (uint32_t)i) & EVENT_MASK];
+}
+
+/**
+ * @brief 幀尾清除本幀事件
+ * 只移動讀取位置，舊事件的內容在被覆寫前仍留在環形佇列中。
+ */
+void EventClear()
+{
+    EventQueue* events = &gWorld->events;
+    events->head += events->count;
+    events->count = 0;
+}
+
+/**
+ * @brief 設定監聽函數
+ */
+void EventSetTap(GameEventTap tap, void* user)
+{
+    EventQueue* events = &gWorld->events;
+    events->tap = tap;
+    events->tapUser = user;
+}
@@ -0,0 +1,60 @@
+#ifndef __EVENT_H__
+#define __EVENT_H__
+#include "brickout.h"
+#include "real.h"
+#include <stdint.h>
+
+// 遊戲事件種類
+typedef enum GameEventType {
+    EVENT_HIT = 0, // 球擊中敵人
+    EVENT_BOUNCE, // 球反彈 (牆壁、玩家板或敵人)
+    EVENT_BALL_LOST, // 球掉出畫面底部
+    EVENT_SPAWN, // 產生新敵人 (由 wave.c 的時間軸寫入)
+} GameEventType;
+
+// 遊戲事件 (偵測階段寫入，各子系統於幀尾批次處理)
+typedef struct GameEvent {
+    uint8_t type; // GameEventType
+    union {
+        struct {
+            RVec2 pos; // 擊中位置
+            int index; // 被擊中的敵人索引 (在本幀內有效)
+        } hit;
+        struct {
+            RVec2 pos; // 反彈位置
+            RVec2 normal; // 反彈面的法向量
+        } bounce;
+        struct {
+            RVec2 pos; // 球掉落的位置
+        } lost;
+        struct {
+            uint8_t eType; // 敵人種類
+            uint8_t path; // 路徑索引
+            uint16_t count; // 一次產生的數量 (同一批寫入敵人陣列)
+            Real speed; // 移動速度
+        } spawn;
+    };
+} GameEvent;
+
+// 事件監聽函數 (遙測、重播錄製用)，每個事件寫入時呼叫
+typedef void (*GameEventTap)(const GameEvent* ev, void* user);
+
+#define MAX_EVENTS 256 // 環形佇列容量 (必須為 2 的冪次)
+
+// 預先配置的事件環形佇列 (每個 GameWorld 各有一個)
+typedef struct {
+    GameEvent ring[MAX_EVENTS];
+    uint32_t head; // 本幀第一個事件的位置 (單調遞增，取餘數後為索引)
+    uint32_t count; // 本幀事件數量
+    GameEventTap tap;
+    void* tapUser;
+} EventQueue;
+
+void EventInit(); // 清空目前世界的事件佇列並移除監聽函數
+void EventPush(GameEvent ev); // 寫入一個事件
+int EventCount(); // 本幀尚未清除的事件數量
+const GameEvent* EventGet(int i); // 取得本幀第 i 個事件 (0 為最早)
+void EventClear(); // 幀尾清除本幀事件
+void EventSetTap(GameEventTap tap, void* user); // 設定監聽函數 (NULL 表示移除)
+
+#endif
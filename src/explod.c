@@ -1,106 +1,122 @@
 #include "explod.h"
 #include "animframe.h"
 #include "brickout.h"
+#include "event.h"
 #include "raylib.h"
+#include "real.h"
+#include "render.h"
+#include "statehash.h"
 #include "timer.h"
+#include "world.h"
 #include <stdint.h>
 #include <stdio.h>
 
-#define MAX_EXPLODS 100
-#define EXPLOD_TIME 0.1f
+#define EXPLOD_FRAME_TICKS TIMER_SECONDS(0.1f) // 每個動畫影格的持續 tick 數
+#define EXPLOD_LIFE_TICKS TIMER_SECONDS(1.0f) // 爆炸持續時間
 
-typedef struct {
-    AnimFrame af;
-    Vec2 pos[MAX_EXPLODS];
-    float frameTime[MAX_EXPLODS];
-    float lifeTime[MAX_EXPLODS];
-    int16_t frameCount[MAX_EXPLODS];
-    int32_t count;
-} Explod;
+static AnimFrame explodAf = { 0 }; // 爆炸貼圖 (不屬於模擬狀態，快照時不保存)
 
-Explod explods = { 0 };
+// 爆炸到期：釋放欄位
+static void ExplodOnExpire(uint32_t i)
+{
+    gWorld->explods.active[i] = 0;
+}
+
+/**
+ * @brief 註冊爆炸使用的計時器回呼 (所有世界共用，建立世界之前呼叫一次)
+ */
+void ExplodTimerInit()
+{
+    gTimer.Register(ExplodOnExpire);
+}
 
 void ExplodInit()
 {
-    explods.af = AnimFrameLoad("asset/explod.png", 32, 32);
+    explodAf = AnimFrameLoad("asset/explod.png", 32, 32);
+    AnimFrameTrack(&explodAf); // 素材熱重載時同步更新
+}
+void ExplodReset()
+{
+    Explod* explods = &gWorld->explods;
     for (int i = 0; i < MAX_EXPLODS; i++) {
-        explods.pos[i] = (Vec2) { 0, 0 };
-        explods.frameTime[i] = 0;
-        explods.lifeTime[i] = 0;
-        explods.frameCount[i] = 0;
+        explods->pos[i] = (RVec2) { 0, 0 };
+        explods->spawnTick[i] = 0;
+        explods->active[i] = 0;
     }
-    explods.count = 0;
+    explods->count = 0;
 }
 void ExplotFini()
 {
-    AnimFrameUnload(&explods.af);
+    AnimFrameUnload(&explodAf);
 }
 
-void ExplodTryAdd(Vec2 pos)
+/**
+ * @brief 一次加入多個爆炸效果 (只掃描一次閒置欄位)
+ */
+void ExplodAddBatch(const RVec2* pos, int n)
 {
-    for (int i = 0; i < MAX_EXPLODS; i++) {
-        if (explods.lifeTime[i] <= 0) { // 如果生命週期 <= 0，表示此爆炸效果已結束或未使用
-            explods.pos[i] = pos;
-            explods.lifeTime[i] = 1.0f;
-            explods.frameTime[i] = 0;
-            explods.frameCount[i] = 0;
-            // 如果使用的索引超出了目前的計數器，則擴大計數器範圍
-            // 這確保了 Update 和 Draw 迴圈會檢查到這個新啟動的爆炸
-            if (i >= explods.count) {
-                explods.count = i + 1; // 更新計數器為目前使用的最大索引 + 1
+    Explod* explods = &gWorld->explods;
+    int k = 0;
+    uint32_t now = gTimer.Tick();
+    for (int i = 0; i < MAX_EXPLODS && k < n; i++) {
+        if (!explods->active[i]) {
+            explods->pos[i] = pos[k++];
+            explods->active[i] = 1;
+            explods->spawnTick[i] = now;
+            gTimer.Schedule(EXPLOD_LIFE_TICKS, ExplodOnExpire, (uint32_t)i);
+            if (i >= explods->count) {
+                explods->count = i + 1;
             }
-            return; // 找到並啟動後即可返回
         }
     }
-    // 如果迴圈結束仍未找到閒置的，表示爆炸效果池已滿，無法再添加
 #ifdef DEBUG
-    printf("Warning: Explod pool is full. Cannot add explosion.\n");
+    if (k < n && gWorld->debugLog) {
+        printf("Warning: Explod pool is full. %d explosions dropped.\n", n - k);
+    }
 #endif
 }
 
-void ExplodUpdate()
+/**
+ * @brief 批次處理本幀事件：每個擊中事件產生一個爆炸
+ */
+void ExplodHandleEvents()
 {
-    float deltaTime = gTimer.DeltaTime();
-    // 遍歷到目前為止使用過的最高索引
-    for (int i = 0; i < explods.count; i++) {
-        if (explods.lifeTime[i] > 0) { // 只更新生命週期 > 0 的活躍爆炸
-            explods.lifeTime[i] -= deltaTime;
-            if (explods.lifeTime[i] <= 0) {
-                explods.lifeTime[i] = 0;
-            }
-            explods.frameTime[i] += deltaTime;
-            if (explods.frameTime[i] >= EXPLOD_TIME) {
-                explods.frameTime[i] -= EXPLOD_TIME;
-                explods.frameCount[i]++;
-                if (explods.frameCount[i] >= explods.af.xCellCount) {
-                    explods.frameCount[i] = 0;
-                }
-            }
+    RVec2 pos[MAX_EVENTS]; // 事件數不超過佇列容量
+    int n = 0;
+    for (int i = 0; i < EventCount(); i++) {
+        const GameEvent* ev = EventGet(i);
+        if (ev->type == EVENT_HIT) {
+            pos[n++] = ev->hit.pos;
         }
     }
+    if (n > 0) {
+        ExplodAddBatch(pos, n);
+    }
 }
 
-void ExplodDraw()
+void ExplodRender(RenderFrame* f)
 {
-    for (int i = 0; i < explods.count; i++) {
-        if (explods.lifeTime[i] == 0) {
+    Explod* explods = &gWorld->explods;
+    uint32_t now = gTimer.Tick();
+    for (int i = 0; i < explods->count; i++) {
+        if (!explods->active[i]) {
             continue;
         }
-        int frame_col = explods.frameCount[i] % explods.af.xCellCount;
-        int frame_row = 0;
-        Rect sourceRec = {
-            (float)(frame_col * explods.af.cellW), // X 座標 = 列號 * 單元寬度
-            (float)(frame_row * explods.af.cellH), // Y 座標 = 行號 * 單元高度 (修正 Bug)
-            (float)explods.af.cellW, // 寬度 = 單元寬度
-            (float)explods.af.cellH // 高度 = 單元高度
-        };
-        Rect destRec = {
-            explods.pos[i].x, // 目標 X 座標
-            explods.pos[i].y, // 目標 Y 座標
-            (float)explods.af.cellW, // 繪製寬度
-            (float)explods.af.cellH // 繪製高度
-        };
-        Vec2 origin = (Vec2) { (float)explods.af.centerW, (float)explods.af.centerH };
-        DrawTexturePro(explods.af.tex, sourceRec, destRec, origin, 0.0F, WHITE);
+        // 由生成的 tick 推算動畫影格，每 EXPLOD_FRAME_TICKS 前進一格
+        RenderPushSprite(f, &explodAf, explods->pos[i], (int)((now - explods->spawnTick[i]) / EXPLOD_FRAME_TICKS), RENDER_CELL);
     }
-}
\ No newline at end of file
+}
+
+// 爆炸的模擬狀態 (快照用)
+StateBlock ExplodStateBlock()
+{
+    return (StateBlock) { &gWorld->explods, sizeof(Explod) };
+}
+
+// 將播放中的爆炸累加進雜湊值
+uint64_t ExplodStateHash(uint64_t h)
+{
+    Explod* explods = &gWorld->explods;
+    h = StateHashBytes(h, &explods->count, sizeof(explods->count));
+    return StateHashBytes(h, explods->active, (size_t)explods->count);
+}
@@ -3,11 +3,30 @@
 
 #include "animframe.h"
 #include "brickout.h"
+#include "real.h"
+#include "snapshot.h"
+#include <stdint.h>
 
-void ExplodInit();
+typedef struct RenderFrame RenderFrame; // render.h
+
+#define MAX_EXPLODS 512 // 同時播放的爆炸上限 (雷射大量命中時每 tick 約 6 次，持續 1 秒)
+
+// 爆炸效果池 (屬於 GameWorld 的模擬狀態)
+typedef struct {
+    RVec2 pos[MAX_EXPLODS];
+    uint32_t spawnTick[MAX_EXPLODS]; // 生成時的 tick (動畫影格由此推算，只用於繪製)
+    uint8_t active[MAX_EXPLODS]; // 非 0 表示播放中 (到期由 gTimer 的計時器清除)
+    int32_t count;
+} Explod;
+
+void ExplodTimerInit(); // 註冊計時器回呼 (建立世界之前呼叫一次)
+void ExplodInit(); // 載入爆炸貼圖
+void ExplodReset(); // 清空目前世界中的爆炸
 void ExplotFini();
-void ExplodTryAdd(Vec2 pos);
-void ExplodUpdate();
-void ExplodDraw();
+void ExplodAddBatch(const RVec2* pos, int n);
+void ExplodHandleEvents();
+void ExplodRender(RenderFrame* f); // 將爆炸加入繪製清單
+StateBlock ExplodStateBlock(); // 爆炸的模擬狀態 (快照用)
+uint64_t ExplodStateHash(uint64_t h); // 將播放中的爆炸累加進雜湊值
 
 #endif
\ No newline at end of file
@@ -1,51 +1,351 @@
+#include "alloctrack.h"
+#include "animframe.h"
+#include "arena.h"
+#include "autopilot.h"
 #include "ball.h"
 #include "brickout.h"
 #include "enemy.h"
+#include "event.h"
 #include "explod.h"
+#include "hotreload.h"
 #include "player.h"
+#include "projectile.h"
+#include "render.h"
+#include "rewind.h"
+#include "snapshot.h"
+#include "statehash.h"
 #include "timer.h"
+#include "world.h"
+#include <pthread.h>
 #include <stdio.h>
 
+#define SNAPSHOT_FILE "brickout.snap" // DEBUG 快速存檔/讀檔的檔案
+#define REWIND_KEYFRAME_INTERVAL 60 // 倒帶緩衝區的關鍵影格間隔 (tick)
+#ifdef FIXED_POINT
+#define GAME_STEP (1.0f / FIXED_TICK_HZ) // 定點模式鎖步：計時器每個 tick 固定前進，不讀取實際幀間時間
+#else
+#define GAME_STEP 0.0f // 使用實際幀間時間
+#endif
+
+static GameWorld mainWorld; // 互動遊戲的世界 (快照、倒帶、雜湊記錄都作用在此)
+
+// 主執行緒讀取的一幀操作 (鍵盤等 raylib 狀態只在主執行緒讀取，再交給推進世界的執行緒)
+typedef struct GameControls {
+    GameInput input;
+    bool rewind; // 按住 Backspace：退回一個 tick
+    bool save; // F5 (DEBUG，由 GameUpdate 在幀內區間之外處理)
+    bool load; // F9 (DEBUG，同上)
+    bool toggleAutopilot; // F2 (DEBUG)
+    uint32_t autopilotSeed;
+} GameControls;
+
+// 管線模式：模擬執行緒推進 tick k 並寫入繪製清單的同時，主執行緒繪製 tick k - 1 的畫面
+// 主執行緒每幀交出一組操作，並等待上一組處理完畢 (模擬最多落後一幀，輸入延遲固定為一幀)。
+typedef struct GamePipeline {
+    pthread_t thread;
+    pthread_mutex_t lock; // 保護 controls/pending/stop
+    pthread_cond_t wake; // 主執行緒 -> 模擬執行緒：有新的操作或要求結束
+    pthread_cond_t done; // 模擬執行緒 -> 主執行緒：操作已處理完畢
+    GameControls controls;
+    bool pending; // controls 尚未處理
+    bool stop;
+    bool running;
+    RenderQueue queue; // 模擬執行緒發佈、主執行緒繪製
+    FrameArenaStats arena; // 模擬執行緒結束時的暫存配置器統計
+    bool arenaValid; // 管線模式結束後、回到循序模式推進世界之前，arena 代表最近推進世界的執行緒
+} GamePipeline;
+
+static GamePipeline pipeline = { .lock = PTHREAD_MUTEX_INITIALIZER, .wake = PTHREAD_COND_INITIALIZER, .done = PTHREAD_COND_INITIALIZER };
+static RenderFrame sequentialFrame; // 非管線模式的繪製清單 (更新後在同一執行緒上取得並繪製)
+static int stressLasers = 0; // 幀時間基準測試：每個 tick 補滿的雷射數 (0 表示關閉)
+
 // 遊戲整體初始化
 void GameInit()
 {
+    FrameArenaInit();
+    WorldInit(&mainWorld, (uint32_t)GetRandomValue(1, INT32_MAX), GAME_STEP);
+    mainWorld.debugLog = true;
     EnemyInit();
-    PlayerInit(PADDLE_W, PADDLE_H); // 初始化玩家，使用宏定義的尺寸
-    BallInit(); // 初始化球
+    PlayerInit(PADDLE_W, PADDLE_H); // 載入玩家板貼圖，使用宏定義的尺寸
+    BallInit(); // 載入球的貼圖
     ExplodInit();
-    gTimer.Init();
+    RewindInit(REWIND_KEYFRAME_INTERVAL);
+    HotReloadInit("asset"); // 以 -DHOT_RELOAD 編譯時監看素材目錄
 }
 
 // 遊戲結束清理
 void GameFinish()
 {
+    GamePipelineStop(); // 模擬執行緒可能仍在寫入雜湊記錄
+    StateHashLogClose();
+    HotReloadFini();
     ExplotFini();
     BallFini();
     PlayerFini();
     EnemyFini();
+#ifdef DEBUG
+    AnimFrameCacheStats stats = AnimFrameCacheGetStats();
+    printf("Texture cache: %u hits, %u misses, %u resident (%zu bytes)\n", stats.hits, stats.misses, stats.entries, stats.residentBytes);
+#endif
+}
+
+/**
+ * @brief 幀時間基準測試：每個 tick 補滿敵人與 stressLasers 發雷射 (平均分布在整個畫面)
+ * 在 WorldStep 之前呼叫；會改變模擬結果，只用於測量。
+ */
+static void GameStress()
+{
+    static uint32_t rng = 1u;
+    for (int k = 0; mainWorld.enemys.count + 10 <= MAX_ENEMYS; k++) { // 補滿被擊落的敵人
+        EnemyAddBatch((EnemyType)(ENEMY_FLY + k % (ENEMY_NUMS - 1)), (int)((gTimer.Tick() + (uint32_t)k) % MAX_PATHS), R(200.0f), 10);
+    }
+    while (mainWorld.projectiles.live < stressLasers) {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        int x = (int)(rng % (SCR_WIDTH - PROJECTILE_W));
+        int y = (int)((rng >> 10) % SCR_HEIGHT);
+        if (!ProjectileFire((RVec2) { RFromInt(x), RFromInt(y) })) {
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 幀時間基準測試：每個 tick 補滿 lasers 發雷射與敵人 (0 表示關閉)
+ */
+void GameSetStress(int lasers)
+{
+    stressLasers = lasers < 0 ? 0 : (lasers > PROJECTILE_MAX ? PROJECTILE_MAX : lasers);
+}
+
+// 讀取本幀的操作 (主執行緒)
+static GameControls GameReadControls()
+{
+    GameControls c = { 0 };
+#ifdef DEBUG
+    c.save = IsKeyPressed(KEY_F5);
+    c.load = IsKeyPressed(KEY_F9);
+    c.toggleAutopilot = IsKeyPressed(KEY_F2);
+    c.autopilotSeed = c.toggleAutopilot ? (uint32_t)GetRandomValue(1, INT32_MAX) : 0u;
+#endif
+    c.rewind = IsKeyDown(KEY_BACKSPACE);
+    c.input.left = IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A);
+    c.input.right = IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D);
+    c.input.fire = IsKeyDown(KEY_SPACE);
+    return c;
+}
+
+// F5 保存快照、F9 還原快照 (幀開頭，事件佇列為空)
+// 檔案 I/O (fopen) 會配置記憶體，因此在配置追蹤的幀內區間之前執行；管線模式下此時模擬執行緒閒置，由本執行緒存取世界
+static void GameSnapshotKeys(const GameControls* c)
+{
+#ifdef DEBUG
+    if (!c->save && !c->load) {
+        return;
+    }
+    WorldBind(&mainWorld);
+    if (c->save && SnapshotWriteFile(SNAPSHOT_FILE)) {
+        printf("Snapshot saved (%zu bytes, %.1f us)\n", SnapshotSize(), SnapshotGetStats().saveUs);
+    }
+    if (c->load && SnapshotReadFile(SNAPSHOT_FILE)) {
+        printf("Snapshot restored (%.1f us)\n", SnapshotGetStats().restoreUs);
+    }
+#else
+    (void)c;
+#endif
+}
+
+// 以一幀的操作推進世界一個 tick (在綁定 mainWorld 的執行緒上，本執行緒的暫存配置器已切換)
+static void GameTick(const GameControls* c)
+{
+#ifdef DEBUG
+    // F2 切換自動駕駛
+    if (c->toggleAutopilot) {
+        if (AutopilotEnabled()) {
+            AutopilotDisable();
+        } else {
+            AutopilotEnable(AUTOPILOT_DEFAULT, c->autopilotSeed);
+        }
+    }
+#endif
+    // 按住 Backspace 倒帶：每幀退回一個 tick，放開後從該狀態繼續
+    if (c->rewind) {
+        gTimer.Update();
+        RewindStepBack();
+        return;
+    }
+    // 鍵盤輸入寫入世界，模擬本身不讀取 raylib 的輸入狀態 (自動駕駛啟用時由 PlayerUpdate 覆寫)
+    mainWorld.input = c->input;
+    if (stressLasers > 0) {
+        GameStress();
+    }
+    WorldStep();
+    StateHashTick(); // 本 tick 的狀態雜湊 (以 -hashlog 啟動時寫入記錄檔)
+    RewindRecord(); // 記錄本 tick 結束時的狀態
+}
+
+// 將目前世界的畫面寫入繪製清單 (在綁定 mainWorld 的執行緒上)
+static void GameCapture(RenderFrame* f)
+{
+    RenderBegin(f, gTimer.Tick());
+    EnemyRender(f);
+    PlayerRender(f); // 玩家板
+    BallRender(f); // 球
+    MultiballRender(f); // 額外的球
+    ProjectileRender(f); // 雷射
+    ExplodRender(f);
+    f->hud.score = PlayerScore();
+    f->hud.autopilot = AutopilotEnabled();
+#ifdef DEBUG
+    f->hud.arena = FrameArenaGetStats();
+    f->hud.rewind = RewindGetStats();
+#endif
+}
+
+// 模擬執行緒：等待主執行緒交出的操作，推進一個 tick 後發佈畫面
+static void* GameSimThread(void* arg)
+{
+    (void)arg;
+    FrameArenaInit(); // 本執行緒的暫存配置器
+    AllocTrackThread(); // 模擬的 tick 同樣不應配置
+    WorldBind(&mainWorld);
+    pthread_mutex_lock(&pipeline.lock);
+    for (;;) {
+        while (!pipeline.pending && !pipeline.stop) {
+            pthread_cond_wait(&pipeline.wake, &pipeline.lock);
+        }
+        if (pipeline.stop) {
+            break;
+        }
+        GameControls c = pipeline.controls;
+        pthread_mutex_unlock(&pipeline.lock);
+        AllocTrackFrameBegin(); // 本執行緒的幀內區間為一個 tick (與主執行緒的區間重疊但不對齊)
+        FrameArenaSwap();
+        GameTick(&c);
+        GameCapture(RenderQueueBack(&pipeline.queue));
+        RenderQueuePublish(&pipeline.queue);
+        AllocTrackFrameEnd();
+        pthread_mutex_lock(&pipeline.lock);
+        pipeline.pending = false;
+        pthread_cond_signal(&pipeline.done);
+    }
+    pthread_mutex_unlock(&pipeline.lock);
+    pipeline.arena = FrameArenaGetStats(); // 由 pthread_join 之後的 GamePipelineStop 讀取
+    return NULL;
+}
+
+/**
+ * @brief 啟動管線模式 (主迴圈開始前、GameInit 之後呼叫)
+ * 之後 mainWorld 只由模擬執行緒讀寫；主執行緒保留視窗、輸入與 GL，只讀取發佈的繪製清單。
+ * 無法建立執行緒時維持循序模式。
+ */
+void GamePipelineStart()
+{
+    if (pipeline.running) {
+        return;
+    }
+    RenderQueueInit(&pipeline.queue);
+    pipeline.pending = false;
+    pipeline.stop = false;
+    pipeline.running = pthread_create(&pipeline.thread, NULL, GameSimThread, NULL) == 0;
+    if (!pipeline.running) {
+        printf("Warning: Cannot start simulation thread, pipeline disabled\n");
+    }
+}
+
+/**
+ * @brief 等待進行中的 tick 完成後結束模擬執行緒，回到循序模式
+ */
+void GamePipelineStop()
+{
+    if (!pipeline.running) {
+        return;
+    }
+    pthread_mutex_lock(&pipeline.lock);
+    while (pipeline.pending) {
+        pthread_cond_wait(&pipeline.done, &pipeline.lock);
+    }
+    pipeline.stop = true;
+    pthread_cond_signal(&pipeline.wake);
+    pthread_mutex_unlock(&pipeline.lock);
+    pthread_join(pipeline.thread, NULL);
+    pipeline.running = false;
+    pipeline.arenaValid = true;
+}
+
+/**
+ * @brief 推進世界的執行緒所使用的暫存配置器統計
+ * 循序模式為目前執行緒；管線模式結束後為模擬執行緒 (執行中不可讀取)。
+ */
+FrameArenaStats GameArenaStats()
+{
+    if (pipeline.arenaValid && !pipeline.running) {
+        return pipeline.arena;
+    }
+    return FrameArenaGetStats();
 }
 
 // 遊戲邏輯更新 (每幀調用)
 void GameUpdate()
 {
-    gTimer.Update();
-    // BrickUpdate(); // 更新磚塊狀態 (例如動畫)
-    EnemyUpdate();
-    PlayerUpdate(); // 更新玩家狀態 (處理輸入)
-    BallUpdate(); // 更新球的狀態 (移動和碰撞)
-    ExplodUpdate();
-    EnemySpawn();
+    HotReloadPoll(); // 幀邊界：套用背景解碼完成的素材 (不計入幀內配置)
+    GameControls c = GameReadControls();
+    if (pipeline.running) { // 等上一個 tick 完成 (其畫面即將繪製)
+        pthread_mutex_lock(&pipeline.lock);
+        while (pipeline.pending) {
+            pthread_cond_wait(&pipeline.done, &pipeline.lock);
+        }
+        pthread_mutex_unlock(&pipeline.lock);
+    }
+    GameSnapshotKeys(&c);
+    AllocTrackFrameBegin(); // 從這裡到 EndDrawing 之間不應有任何配置
+    FrameArenaSwap(); // 上一幀的暫存資料保留給繪圖，兩幀前的被回收
+    if (pipeline.running) { // 交出本幀的操作
+        pthread_mutex_lock(&pipeline.lock);
+        pipeline.controls = c;
+        pipeline.pending = true;
+        pthread_cond_signal(&pipeline.wake);
+        pthread_mutex_unlock(&pipeline.lock);
+        return;
+    }
+    WorldBind(&mainWorld);
+    pipeline.arenaValid = false; // 世界回到本執行緒推進
+    GameTick(&c);
 }
 
 // 遊戲畫面繪製 (每幀調用)
 void GameDraw()
 {
-    EnemyDraw();
-    PlayerDraw(); // 繪製玩家板
-    BallDraw(); // 繪製球
-    ExplodDraw();
+    const RenderFrame* f;
+    if (pipeline.running) {
+        f = RenderQueueAcquire(&pipeline.queue); // 上一個 tick 的畫面 (模擬執行緒正在推進本幀的 tick)
+    } else {
+        WorldBind(&mainWorld);
+        GameCapture(&sequentialFrame);
+        f = &sequentialFrame;
+    }
+    RenderDraw(f);
     // 繪製分數文字
     char text[64]; // 足夠長的字串緩衝區
-    snprintf(text, sizeof(text), "SCORE: %d", PlayerScore()); // 使用 snprintf 更安全
+    snprintf(text, sizeof(text), f->hud.autopilot ? "SCORE: %d (AUTO)" : "SCORE: %d", f->hud.score); // 使用 snprintf 更安全
     DrawText(text, 100, 10, 30, YELLOW); // 分數顯示在左下角
-}
\ No newline at end of file
+#ifdef DEBUG
+    // 紋理快取狀態，長時間執行時常駐位元組數應保持不變
+    AnimFrameCacheStats stats = AnimFrameCacheGetStats();
+    snprintf(text, sizeof(text), "TEX: %u hit %u miss %zu KB", stats.hits, stats.misses, stats.residentBytes / 1024);
+    DrawText(text, 10, 40, 20, GREEN);
+    // 模擬執行緒的每幀暫存配置器使用量
+    FrameArenaStats arenaStats = f->hud.arena;
+    snprintf(text, sizeof(text), "ARENA: %zu/%zu B peak %zu", arenaStats.used, arenaStats.capacity, arenaStats.highWater);
+    DrawText(text, 10, 60, 20, GREEN);
+    // 上一幀的配置次數，穩定狀態下應為 0
+    AllocFrameStats allocStats = AllocTrackLastFrame();
+    snprintf(text, sizeof(text), "ALLOC: %u (%zu B) per frame", allocStats.allocs, allocStats.bytes);
+    DrawText(text, 10, 80, 20, allocStats.allocs == 0 ? GREEN : RED);
+    // 倒帶緩衝區的記錄長度、壓縮比與跳轉耗時
+    RewindStats rewindStats = f->hud.rewind;
+    snprintf(text, sizeof(text), "REWIND: %u ticks %zu KB x%.1f seek %.0f us", rewindStats.entries, rewindStats.storedBytes / 1024, rewindStats.ratio, rewindStats.seekUs);
+    DrawText(text, 10, 100, 20, GREEN);
+#endif
+}
@@ -0,0 +1,177 @@
+#define _POSIX_C_SOURCE 200809L // NAME_MAX (-std=c2x 下需明確要求 POSIX 宣告)
+#include "hotreload.h"
+
+#if defined(HOT_RELOAD) && defined(__linux__)
+
+#include "animframe.h"
+#include "raylib.h"
+#include <limits.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#define MAX_PENDING 16 // 等待套用的影像數量上限
+#define PATH_LEN 256 // 監看目錄的最大長度
+#define FILE_PATH_LEN (PATH_LEN + NAME_MAX + 2) // 目錄 + "/" + 檔名 + 結尾
+#define WATCH_POLL_MS 200 // 監看執行緒檢查結束旗標的間隔 (毫秒)
+
+// 已在背景解碼、等待主執行緒套用的影像
+typedef struct {
+    char path[FILE_PATH_LEN]; // 與 AnimFrameLoad 相同形式的路徑 (快取鍵)
+    Image img;
+} PendingImage;
+
+typedef struct {
+    pthread_t thread;
+    pthread_mutex_t lock; // 保護 pending/pendingCount
+    atomic_bool running;
+    int fd; // inotify 檔案描述子
+    char dir[PATH_LEN]; // 監看的目錄
+    PendingImage pending[MAX_PENDING];
+    int pendingCount;
+} HotReload;
+
+static HotReload hotReload = { .fd = -1, .lock = PTHREAD_MUTEX_INITIALIZER };
+
+// 判斷檔名是否為可重載的圖片
+static bool IsImageFile(const char* name)
+{
+    const char* ext = strrchr(name, '.');
+    return ext != NULL && strcmp(ext, ".png") == 0;
+}
+
+// 將解碼好的影像放入待套用佇列 (同一檔案只保留最新的一份)
+static void PushPending(const char* path, Image img)
+{
+    pthread_mutex_lock(&hotReload.lock);
+    for (int i = 0; i < hotReload.pendingCount; i++) {
+        if (strcmp(hotReload.pending[i].path, path) == 0) {
+            UnloadImage(hotReload.pending[i].img);
+            hotReload.pending[i].img = img;
+            pthread_mutex_unlock(&hotReload.lock);
+            return;
+        }
+    }
+    if (hotReload.pendingCount < MAX_PENDING) {
+        PendingImage* p = &hotReload.pending[hotReload.pendingCount++];
+        snprintf(p->path, sizeof(p->path), "%s", path);
+        p->img = img;
+    } else {
+        UnloadImage(img); // 佇列已滿，捨棄此次更新 (下一次存檔會再觸發)
+    }
+    pthread_mutex_unlock(&hotReload.lock);
+}
+
+// 監看執行緒：等待 inotify 事件並在背景解碼圖片
+static void* WatchThread(void* arg)
+{
+    (void)arg;
+    char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    struct pollfd pfd = { .fd = hotReload.fd, .events = POLLIN };
+    while (atomic_load(&hotReload.running)) {
+        if (poll(&pfd, 1, WATCH_POLL_MS) <= 0) {
+            continue;
+        }
+        ssize_t len = read(hotReload.fd, buf, sizeof(buf));
+        for (char* p = buf; len > 0 && p < buf + len;) {
+            struct inotify_event* ev = (struct inotify_event*)p;
+            p += sizeof(struct inotify_event) + ev->len;
+            if (ev->len == 0 || !IsImageFile(ev->name)) {
+                continue;
+            }
+            char path[FILE_PATH_LEN];
+            snprintf(path, sizeof(path), "%s/%s", hotReload.dir, ev->name);
+            Image img = LoadImage(path); // 只在 CPU 端解碼，不觸碰 GL
+            if (img.data == NULL) {
+                printf("Warning: Hot reload failed to decode %s\n", path);
+                continue;
+            }
+            PushPending(path, img);
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 啟動監看執行緒
+ */
+void HotReloadInit(const char* dir)
+{
+    snprintf(hotReload.dir, sizeof(hotReload.dir), "%s", dir);
+    hotReload.fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (hotReload.fd < 0) {
+        printf("Warning: inotify unavailable, hot reload disabled\n");
+        return;
+    }
+    // 編輯器多半以「寫入後關閉」或「寫入暫存檔再改名」的方式存檔
+    if (inotify_add_watch(hotReload.fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        printf("Warning: Cannot watch %s, hot reload disabled\n", dir);
+        close(hotReload.fd);
+        hotReload.fd = -1;
+        return;
+    }
+    atomic_store(&hotReload.running, true);
+    if (pthread_create(&hotReload.thread, NULL, WatchThread, NULL) != 0) {
+        atomic_store(&hotReload.running, false);
+        close(hotReload.fd);
+        hotReload.fd = -1;
+    }
+}
+
+/**
+ * @brief 停止監看執行緒並釋放未套用的影像
+ */
+void HotReloadFini()
+{
+    if (hotReload.fd < 0) {
+        return;
+    }
+    atomic_store(&hotReload.running, false);
+    pthread_join(hotReload.thread, NULL);
+    close(hotReload.fd);
+    hotReload.fd = -1;
+    for (int i = 0; i < hotReload.pendingCount; i++) {
+        UnloadImage(hotReload.pending[i].img);
+    }
+    hotReload.pendingCount = 0;
+}
+
+/**
+ * @brief 套用已解碼的影像
+ * 在 GameUpdate 開頭 (繪圖之前) 呼叫，因此 EnemyDraw/ExplodDraw 在同一幀內只會看到
+ * 完整的舊紋理或完整的新紋理。取鎖失敗時直接略過，留待下一幀，繪圖執行緒不會因此等待。
+ */
+void HotReloadPoll()
+{
+    PendingImage ready[MAX_PENDING];
+    int count = 0;
+    if (hotReload.fd < 0 || pthread_mutex_trylock(&hotReload.lock) != 0) {
+        return;
+    }
+    count = hotReload.pendingCount;
+    memcpy(ready, hotReload.pending, sizeof(PendingImage) * count);
+    hotReload.pendingCount = 0;
+    pthread_mutex_unlock(&hotReload.lock);
+
+    for (int i = 0; i < count; i++) {
+        if (AnimFrameCacheReplace(ready[i].path, ready[i].img)) {
+            printf("Hot reload: %s\n", ready[i].path);
+        }
+        UnloadImage(ready[i].img);
+    }
+}
+
+#else
+
+void HotReloadInit(const char* dir)
+{
+    (void)dir;
+}
+void HotReloadFini() { }
+void HotReloadPoll() { }
+
+#endif
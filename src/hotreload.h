@@ -0,0 +1,12 @@
+#ifndef __HOTRELOAD_H__
+#define __HOTRELOAD_H__
+
+// 素材熱重載 (僅在以 -DHOT_RELOAD 編譯且為 Linux 時啟用，否則以下函數皆為空操作)
+// 背景執行緒以 inotify 監看素材目錄，在背景解碼更新後的圖片，
+// 主執行緒於每幀開頭呼叫 HotReloadPoll() 將新影像換入紋理快取。
+
+void HotReloadInit(const char* dir); // 啟動監看執行緒
+void HotReloadFini(); // 停止監看執行緒並釋放未套用的影像
+void HotReloadPoll(); // 套用已解碼的影像 (僅在繪圖執行緒、幀與幀之間呼叫)
+
+#endif
@@ -1,27 +1,214 @@
+#include "alloctrack.h"
+#include "autopilot.h"
+#include "batch.h"
+#include "bench.h"
 #include "brickout.h"
+#include "env.h"
+#include "multiball.h"
 #include "raylib.h"
+#include "statehash.h"
+#include "wave.h"
+#include "world.h"
 
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define HASH_DIFF_MAX_TICKS (1 << 22) // 比對記錄檔時可容納的 tick 數 (約 16 小時 @ 60Hz)
+#define WAVE_FILE "asset/waves.txt" // 預設的敵人波次時間軸
+
+// 比對兩個雜湊記錄檔，輸出第一個分歧的 tick
+static int HashDiff(const char* pathA, const char* pathB)
+{
+    uint64_t* a = malloc(sizeof(uint64_t) * HASH_DIFF_MAX_TICKS);
+    uint64_t* b = malloc(sizeof(uint64_t) * HASH_DIFF_MAX_TICKS);
+    if (a == NULL || b == NULL) {
+        free(a);
+        free(b);
+        return 1;
+    }
+    int na = StateHashLoadLog(pathA, a, HASH_DIFF_MAX_TICKS);
+    int nb = StateHashLoadLog(pathB, b, HASH_DIFF_MAX_TICKS);
+    if (na == 0 || nb == 0) { // 無法讀取或空的記錄檔不能視為相同
+        free(a);
+        free(b);
+        return 1;
+    }
+    int n = na < nb ? na : nb;
+    int tick = StateHashFindDivergence(a, b, n);
+    if (tick < 0) {
+        printf("Identical for %d ticks\n", n);
+    } else {
+        printf("First divergence at tick %d: %016llx vs %016llx\n", tick, (unsigned long long)a[tick], (unsigned long long)b[tick]);
+    }
+    free(a);
+    free(b);
+    return tick < 0 ? 0 : 2;
+}
+
+// 無視窗平行推進多個世界，輸出合計吞吐量
+static int Batch(int worlds, int ticks, int threads, const AutopilotConfig* pilot)
+{
+    BatchStats stats = BatchRun(worlds, (uint32_t)ticks, threads, 1u, pilot);
+    if (stats.worlds == 0) {
+        return 1;
+    }
+    printf("[metrics] batch worlds=%d threads=%d ticks=%llu time=%.3fs rate=%.0f ticks/s (%.0f per thread) score=%lld hash=%016llx\n",
+        stats.worlds, stats.threads, (unsigned long long)stats.ticks, stats.seconds, stats.ticksPerSec,
+        stats.ticksPerSec / stats.threads, (long long)stats.totalScore, (unsigned long long)stats.hash);
+    return 0;
+}
+
+// 主遊戲迴圈的一幀
+static void GameFrame()
+{
+    GameUpdate(); // 更新遊戲邏輯 (管線模式下交給模擬執行緒)
+    BeginDrawing(); // 開始繪圖模式
+    ClearBackground(BLACK); // 清空背景為黑色
+    GameDraw(); // 繪製遊戲物件
+#ifdef DEBUG
+    DrawFPS(10, 10); // 在左上角顯示 FPS
+#endif
+    EndDrawing(); // 結束繪圖模式
+    AllocTrackFrameEnd(); // 結束本幀的配置統計
+}
 
 // 主函數入口
-int main()
+// 選項: -hashlog <檔案>    記錄每個 tick 的狀態雜湊
+//       -hashdiff <a> <b>  比對兩個雜湊記錄檔並結束
+//       -batch <世界數> <tick 數> [執行緒數]  無視窗批次模擬並結束 (執行緒數預設為全部核心，使用自動駕駛)
+//       -env <環境數> <步數>  以隨機動作量測向量化環境的吞吐量並結束
+//       -autopilot <誤差像素> <延遲 tick>  以自動駕駛遊玩 (長時間無人值守測試)，並作為 -batch 的自動駕駛參數
+//       -enemybench <敵人數> <tick 數>  比較熱冷分離前後的敵人佈局 (每個敵人讀寫的位元組數與更新吞吐量) 並結束
+//       -scriptbench <敵人數> <tick 數>  量測敵人行為腳本的吞吐量並結束
+//       -laserbench <雷射數> <tick 數>  量測維持大量雷射時每個 tick 的模擬耗時並結束
+//       -raybench <射線數>  量測射線查詢的吞吐量 (並與逐一測試的結果比對) 並結束
+//       -ballbench <球數> <tick 數>  量測球對球碰撞的吞吐量並結束
+//       -realbench <tick 數>  以自動駕駛推進一個無視窗世界，輸出數值模式 (float/定點)、每個 tick 的耗時與狀態雜湊並結束
+//                          (與 -hashlog 併用時記錄每個 tick 的雜湊值；兩個建置的記錄檔以 -hashdiff 比對)
+//       -nearbench <點數> <查詢數>  量測最近鄰索引的建立時間與查詢吞吐量 (並與逐一測試比對) 並結束
+//       -sapbench <敵人數> <tick 數>  量測敵人分離 (掃描與剪除) 的耗時 (並與兩兩測試比對) 並結束
+//       -multiball <球數>  多球模式：每局額外的球數 (最多 MULTIBALL_MAX - 1)，也用於 -batch 與 -env
+//       -waves <檔案>      敵人波次時間軸 (預設 WAVE_FILE，不存在時使用內建時間軸)，也用於 -batch 與 -env
+//       -pipeline          管線模式：模擬執行緒推進下一個 tick 的同時主執行緒繪製上一個 (輸入延遲一幀)
+//       -framebench <幀數> <雷射數>  不限制幀率，以循序與管線模式各執行指定幀數 (每個 tick 補滿敵人與雷射)，輸出幀時間並結束
+int main(int argc, char** argv)
 {
+    const char* hashLog = NULL;
+    const char* waveFile = NULL;
+    bool autopilot = false;
+    AutopilotConfig pilot = AUTOPILOT_DEFAULT;
+    int batchWorlds = 0, batchTicks = 0, batchThreads = 0;
+    int envCount = 0, envSteps = 0;
+    int frameBench = 0, frameLasers = 0;
+    int realTicks = 0;
+    bool pipelined = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-hashdiff") == 0 && i + 2 < argc) {
+            return HashDiff(argv[i + 1], argv[i + 2]);
+        }
+        if (strcmp(argv[i], "-enemybench") == 0 && i + 2 < argc) {
+            return EnemyBench(atoi(argv[i + 1]), atoi(argv[i + 2]));
+        }
+        if (strcmp(argv[i], "-scriptbench") == 0 && i + 2 < argc) {
+            return ScriptBench(atoi(argv[i + 1]), atoi(argv[i + 2]));
+        }
+        if (strcmp(argv[i], "-laserbench") == 0 && i + 2 < argc) {
+            return LaserBench(atoi(argv[i + 1]), atoi(argv[i + 2]));
+        }
+        if (strcmp(argv[i], "-ballbench") == 0 && i + 2 < argc) {
+            return BallBench(atoi(argv[i + 1]), atoi(argv[i + 2]));
+        }
+        if (strcmp(argv[i], "-nearbench") == 0 && i + 2 < argc) {
+            return NearestBench(atoi(argv[i + 1]), atoi(argv[i + 2]));
+        }
+        if (strcmp(argv[i], "-sapbench") == 0 && i + 2 < argc) {
+            return SweepBench(atoi(argv[i + 1]), atoi(argv[i + 2]));
+        }
+        if (strcmp(argv[i], "-raybench") == 0 && i + 1 < argc) {
+            return RayBench(atoi(argv[i + 1]));
+        }
+        if (strcmp(argv[i], "-env") == 0 && i + 2 < argc) {
+            envCount = atoi(argv[++i]);
+            envSteps = atoi(argv[++i]);
+        }
+        if (strcmp(argv[i], "-batch") == 0 && i + 2 < argc) {
+            batchWorlds = atoi(argv[++i]);
+            batchTicks = atoi(argv[++i]);
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                batchThreads = atoi(argv[++i]);
+            }
+        }
+        if (strcmp(argv[i], "-autopilot") == 0 && i + 2 < argc) {
+            autopilot = true;
+            pilot.errorPx = (float)atof(argv[++i]);
+            pilot.latencyTicks = atoi(argv[++i]);
+        }
+        if (strcmp(argv[i], "-hashlog") == 0 && i + 1 < argc) {
+            hashLog = argv[++i];
+        }
+        if (strcmp(argv[i], "-waves") == 0 && i + 1 < argc) {
+            waveFile = argv[++i];
+        }
+        if (strcmp(argv[i], "-multiball") == 0 && i + 1 < argc) {
+            MultiballSetCount(atoi(argv[++i]));
+        }
+        if (strcmp(argv[i], "-pipeline") == 0) {
+            pipelined = true;
+        }
+        if (strcmp(argv[i], "-framebench") == 0 && i + 2 < argc) {
+            frameBench = atoi(argv[++i]);
+            frameLasers = atoi(argv[++i]);
+        }
+        if (strcmp(argv[i], "-realbench") == 0 && i + 1 < argc) {
+            realTicks = atoi(argv[++i]);
+        }
+    }
+    if (waveFile != NULL) {
+        if (!WaveLoad(waveFile)) {
+            return 1; // 明確指定的時間軸無效時不以預設值繼續
+        }
+    } else if (FileExists(WAVE_FILE)) {
+        WaveLoad(WAVE_FILE);
+    }
+    if (envCount > 0) {
+        return EnvBench(envCount, envSteps);
+    }
+    if (batchWorlds > 0) {
+        return Batch(batchWorlds, batchTicks, batchThreads, &pilot);
+    }
+    if (realTicks > 0) {
+        if (hashLog != NULL && !StateHashLogOpen(hashLog)) {
+            return 1;
+        }
+        int rc = RealBench(realTicks, &pilot);
+        StateHashLogClose();
+        return rc;
+    }
     SetTraceLogLevel(LOG_ERROR);
     InitWindow(SCR_WIDTH, SCR_HEIGHT, "Raylib :: Brickout Enhanced"); // 初始化 Raylib 視窗
     SetTargetFPS(60); // 設定目標幀率為 60 FPS
     GameInit(); // 初始化遊戲狀態
-    // 主遊戲迴圈
-    while (!WindowShouldClose()) { // 當視窗未被要求關閉時循環
-        GameUpdate(); // 更新遊戲邏輯
-        BeginDrawing(); // 開始繪圖模式
-        ClearBackground(BLACK); // 清空背景為黑色
-        GameDraw(); // 繪製遊戲物件
-#ifdef DEBUG
-        DrawFPS(10, 10); // 在左上角顯示 FPS
-#endif
-        EndDrawing();     // 結束繪圖模式
+    if (autopilot) {
+        AutopilotEnable(pilot, (uint32_t)GetRandomValue(1, INT32_MAX));
+    }
+    if (hashLog != NULL) {
+        StateHashLogOpen(hashLog);
+    }
+    AllocTrackInit(DEBUG); // 以 -DALLOC_TRACK 編譯時追蹤配置，DEBUG 下暖機後幀內配置會中止程式
+    int rc = 0;
+    if (frameBench > 0) {
+        rc = FrameBench(frameBench, frameLasers, GameFrame);
+    } else {
+        if (pipelined) {
+            GamePipelineStart(); // 模擬在另一個執行緒上與繪圖重疊
+        }
+        // 主遊戲迴圈
+        while (!WindowShouldClose()) { // 當視窗未被要求關閉時循環
+            GameFrame();
+        }
     }
     GameFinish();    // 遊戲結束前的清理工作
     CloseWindow();   // 關閉 Raylib 視窗
-    return 0; // 程式正常退出
-}
\ No newline at end of file
+    return rc; // 程式正常退出 (基準測試的穩定狀態檢查失敗時為 1)
+}
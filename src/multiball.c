@@ -0,0 +1,246 @@
+#include "multiball.h"
+#include "arena.h"
+#include "ball.h"
+#include "event.h"
+#include "nearest.h"
+#include "render.h"
+#include "statehash.h"
+#include "world.h"
+#include <string.h>
+
+#define MULTIBALL_SPACING 20 // 額外球出現時的水平間距 (像素，大於 BALL_SIZE 才不會一出現就重疊)
+#define MULTIBALL_ROW_OFFSET R(40.0f) // 額外球出現在主球上方的距離
+
+_Static_assert(MULTIBALL_MAX * MULTIBALL_SPACING <= SCR_WIDTH, "the spawn row must fit on screen");
+
+static int extraBalls = 0; // 每局額外的球數 (所有世界共用，只在建立世界之前設定)
+
+/**
+ * @brief 設定每局額外的球數 (0 表示關閉多球模式)
+ * 超出 MULTIBALL_MAX - 1 時截斷。
+ */
+void MultiballSetCount(int extra)
+{
+    extraBalls = extra < 0 ? 0 : (extra > MULTIBALL_MAX - 1 ? MULTIBALL_MAX - 1 : extra);
+}
+
+/**
+ * @brief 重設目前世界的額外球
+ * 在主球上方排成一列，方向由左上到右上均勻散開，速度與主球相同；須在 BallReset 之後呼叫。
+ */
+void MultiballReset()
+{
+    Multiball* m = &gWorld->multiball;
+    const Ball* ball = &gWorld->ball;
+    int n = extraBalls;
+    m->count = 1 + n;
+    for (int k = 0; k < n; k++) {
+        int i = 1 + k;
+        m->pos[i] = (RVec2) { ball->pos.x + RFromInt((2 * k - (n - 1)) * MULTIBALL_SPACING / 2), ball->pos.y - MULTIBALL_ROW_OFFSET };
+        Real turns = R(0.55f) + RDiv(RMul(R(0.4f), RFromInt(2 * k + 1)), RFromInt(2 * n)); // (0.5, 1) 圈：向上
+        m->dir[i] = (RVec2) { RCosTurns(turns), RSinTurns(turns) };
+        m->speed[i] = ball->velocity;
+    }
+}
+
+static int ClampCell(int c, int n)
+{
+    return c < 0 ? 0 : (c >= n ? n - 1 : c);
+}
+
+// 以速度向量設定球的方向與速度 (速度為 0 時保留原本的方向)
+static void BallSetVelocity(BallView v, uint32_t i, RVec2 vel)
+{
+    Real speed = RSqrtWide(RVec2LengthSqr(vel));
+    if (speed > 0) {
+        v.dir[i] = (RVec2) { RDiv(vel.x, speed), RDiv(vel.y, speed) };
+    }
+    v.speed[i] = speed;
+}
+
+// 兩顆球重疊時推開，互相接近時交換法線方向的速度分量 (質量相同的彈性碰撞)，返回是否接觸
+static bool BallResolve(BallView v, uint32_t i, uint32_t j, Real minDist, RealWide minDist2)
+{
+    RVec2 d = RVec2Sub(v.pos[j], v.pos[i]);
+    if (d.x >= minDist || d.x <= -minDist || d.y >= minDist || d.y <= -minDist) { // 先以外框排除
+        return false;
+    }
+    RealWide d2 = RVec2LengthSqr(d);
+    if (d2 >= minDist2) {
+        return false;
+    }
+    Real dist = RSqrtWide(d2);
+    RVec2 n = dist > 0 ? (RVec2) { RDiv(d.x, dist), RDiv(d.y, dist) } : (RVec2) { 0, R(1.0f) }; // 由 i 指向 j，重合時沿 y 分開
+    RVec2 vi = RVec2Scale(v.dir[i], v.speed[i]);
+    RVec2 vj = RVec2Scale(v.dir[j], v.speed[j]);
+    Real approach = RMul(vi.x - vj.x, n.x) + RMul(vi.y - vj.y, n.y); // 沿法線互相接近的速度
+    if (approach > 0) { // 已經在分離的球只推開，不再反彈
+        RVec2 dv = RVec2Scale(n, approach);
+        BallSetVelocity(v, i, RVec2Sub(vi, dv));
+        BallSetVelocity(v, j, RVec2Add(vj, dv));
+    }
+    RVec2 push = RVec2Scale(n, (minDist - dist) / 2); // 各退一半的重疊量
+    v.pos[i] = RVec2Sub(v.pos[i], push);
+    v.pos[j] = RVec2Add(v.pos[j], push);
+    return true;
+}
+
+/**
+ * @brief 建立格子並解決所有重疊的球
+ * 計數排序：先統計各格子的球數，前綴和之後由後往前放入，同一格子中的球維持索引順序 (結果與執行緒、平台無關)。
+ * 每顆球測試同一格中排在後面的球，以及右、左下、下、右下 4 個格子 (另外 4 個方向由對方負責)。
+ *
+ * @param pairs 累加測試的球對數 (基準測試用，可為 NULL)
+ * @return 接觸的球對數
+ */
+uint32_t BallCollide(BallView v, BallGrid g, uint32_t* pairs)
+{
+    int cells = g.cols * g.rows;
+    memset(g.cellStart, 0, sizeof(uint32_t) * (size_t)(cells + 1));
+    for (int i = 0; i < v.count; i++) {
+        int cx = ClampCell(RFloorInt(v.pos[i].x) / BALL_SIZE, g.cols);
+        int cy = ClampCell(RFloorInt(v.pos[i].y) / BALL_SIZE, g.rows);
+        uint32_t c = (uint32_t)(cy * g.cols + cx);
+        g.cellOf[i] = c;
+        g.cellStart[c]++;
+    }
+    for (int c = 1; c <= cells; c++) { // cellStart[c] 成為格子 c 的結尾
+        g.cellStart[c] += g.cellStart[c - 1];
+    }
+    for (int i = v.count - 1; i >= 0; i--) { // 放入後 cellStart[c] 退回格子 c 的開頭
+        g.items[--g.cellStart[g.cellOf[i]]] = (uint32_t)i;
+    }
+    Real minDist = v.radius + v.radius;
+    RealWide minDist2 = RMulWide(minDist, minDist);
+    uint32_t tested = 0, contacts = 0;
+    for (uint32_t k = 0; k < (uint32_t)v.count; k++) {
+        uint32_t i = g.items[k];
+        uint32_t c = g.cellOf[i];
+        int cx = (int)c % g.cols;
+        int cy = (int)c / g.cols;
+        for (uint32_t m = k + 1; m < g.cellStart[c + 1]; m++) { // 同一格中排在後面的球
+            tested++;
+            contacts += BallResolve(v, i, g.items[m], minDist, minDist2);
+        }
+        uint32_t next[4];
+        int n = 0;
+        if (cx + 1 < g.cols) {
+            next[n++] = c + 1;
+        }
+        if (cy + 1 < g.rows) {
+            for (int nx = cx - 1; nx <= cx + 1; nx++) {
+                if (nx >= 0 && nx < g.cols) {
+                    next[n++] = (uint32_t)((cy + 1) * g.cols + nx);
+                }
+            }
+        }
+        for (int e = 0; e < n; e++) {
+            for (uint32_t m = g.cellStart[next[e]]; m < g.cellStart[next[e] + 1]; m++) {
+                tested++;
+                contacts += BallResolve(v, i, g.items[m], minDist, minDist2);
+            }
+        }
+    }
+    if (pairs != NULL) {
+        *pairs += tested;
+    }
+    return contacts;
+}
+
+/**
+ * @brief 移動額外的球並解決所有球 (含主球) 之間的碰撞
+ * 額外的球與主球一樣會擊中敵人、被牆壁與玩家板反彈；掉出畫面底部時直接移除，不算失球。
+ */
+void MultiballUpdate()
+{
+    Multiball* m = &gWorld->multiball;
+    if (m->count <= 1) {
+        return;
+    }
+    Ball* ball = &gWorld->ball;
+    for (int i = m->count - 1; i >= 1; i--) { // 由後往前，掉落的球以已處理過的最後一顆取代
+        if (BallMove(&m->pos[i], &m->dir[i], m->speed[i], ball->radius)) {
+            m->count--;
+            m->pos[i] = m->pos[m->count];
+            m->dir[i] = m->dir[m->count];
+            m->speed[i] = m->speed[m->count];
+        }
+    }
+    m->pos[0] = ball->pos;
+    m->dir[0] = ball->acceleration;
+    m->speed[0] = ball->velocity;
+    MultiballGrid* grid = &gWorld->ballGrid;
+    BallView v = { m->pos, m->dir, m->speed, m->count, ball->radius };
+    BallCollide(v, (BallGrid) { BALL_GRID_W, BALL_GRID_H, grid->cellStart, grid->items, grid->cellOf }, NULL);
+    ball->pos = m->pos[0];
+    ball->acceleration = m->dir[0];
+    ball->velocity = m->speed[0];
+}
+
+/**
+ * @brief 各查詢點最近的球 (含主球) 的位置 (追蹤最近的球的敵人使用)
+ * 只有主球時直接返回主球；多球時以每幀暫存配置器建立最近鄰索引後批次查詢。
+ */
+void MultiballNearest(const RVec2* query, int n, RVec2* out)
+{
+    Multiball* m = &gWorld->multiball;
+    RVec2 primary = gWorld->ball.pos;
+    int count = m->count;
+    uint32_t* cellStart = count > 1 ? FRAME_NEW(uint32_t, NEAREST_MAX_CELLS(count) + 1) : NULL;
+    uint32_t* items = count > 1 ? FRAME_NEW(uint32_t, count) : NULL;
+    uint32_t* cellOf = count > 1 ? FRAME_NEW(uint32_t, count) : NULL;
+    int32_t* nearest = count > 1 ? FRAME_NEW(int32_t, n) : NULL;
+    if (cellStart == NULL || items == NULL || cellOf == NULL || nearest == NULL) {
+        for (int i = 0; i < n; i++) {
+            out[i] = primary;
+        }
+        return;
+    }
+    m->pos[0] = primary; // 欄位 0 在 MultiballUpdate 之前仍是上一個 tick 的複本
+    NearestIndex ix;
+    NearestBuild(&ix, m->pos, count, cellStart, items, cellOf);
+    NearestBatch(&ix, query, n, R(SCR_WIDTH + SCR_HEIGHT), nearest);
+    for (int i = 0; i < n; i++) {
+        out[i] = nearest[i] >= 0 ? m->pos[nearest[i]] : primary;
+    }
+}
+
+// 批次處理本幀事件：主球掉落時重設額外的球 (BallHandleEvents 已重設主球)
+void MultiballHandleEvents()
+{
+    for (int i = 0; i < EventCount(); i++) {
+        if (EventGet(i)->type == EVENT_BALL_LOST) {
+            MultiballReset();
+            return;
+        }
+    }
+}
+
+void MultiballRender(RenderFrame* f)
+{
+    Multiball* m = &gWorld->multiball;
+    for (int i = 1; i < m->count; i++) {
+        BallRenderAt(f, m->pos[i]);
+    }
+}
+
+/**
+ * @brief 多球的模擬狀態 (快照用)
+ */
+StateBlock MultiballStateBlock()
+{
+    return (StateBlock) { &gWorld->multiball, sizeof(Multiball) };
+}
+
+/**
+ * @brief 將額外的球累加進雜湊值 (欄位 0 是主球的複本，由 BallStateHash 負責)
+ */
+uint64_t MultiballStateHash(uint64_t h)
+{
+    Multiball* m = &gWorld->multiball;
+    size_t n = (size_t)(m->count - 1);
+    h = StateHashBytes(h, &m->count, sizeof(m->count));
+    h = StateHashBytes(h, m->pos + 1, sizeof(RVec2) * n);
+    h = StateHashBytes(h, m->dir + 1, sizeof(RVec2) * n);
+    return StateHashBytes(h, m->speed + 1, sizeof(Real) * n);
+}
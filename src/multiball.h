@@ -0,0 +1,63 @@
+#ifndef __MULTIBALL_H__
+#define __MULTIBALL_H__
+#include "brickout.h"
+#include "real.h"
+#include "snapshot.h"
+#include <stdint.h>
+
+typedef struct RenderFrame RenderFrame; // render.h
+
+// 多球模式與球對球的彈性碰撞
+// 球的位置以計數排序放進均勻格子 (每格 BALL_SIZE 像素，等於球的直徑)，每個 tick 重新建立；
+// 互相接觸的兩顆球必定位於相同或相鄰的格子，每顆球只需測試自己的格子與前方 4 個相鄰格子 (每對只測一次)，
+// 測試次數與球數成正比。質量相同的彈性碰撞只需交換兩顆球在法線方向上的速度分量。
+
+#define MULTIBALL_MAX 32 // 每個世界同時存在的球數上限 (含主球)
+#define BALL_GRID_W ((SCR_WIDTH + BALL_SIZE - 1) / BALL_SIZE) // 世界中的格子覆蓋整個畫面
+#define BALL_GRID_H ((SCR_HEIGHT + BALL_SIZE - 1) / BALL_SIZE)
+#define BALL_GRID_CELLS (BALL_GRID_W * BALL_GRID_H)
+
+// 球對球碰撞操作的球陣列 (SoA，由 MultiballUpdate 指向世界的球，或由基準測試自行配置)
+typedef struct BallView {
+    RVec2* pos; // 中心位置
+    RVec2* dir; // 移動方向 (單位向量，與 Ball.acceleration 相同)
+    Real* speed; // 速度 (純量，與 Ball.velocity 相同)
+    int count;
+    Real radius; // 所有球的半徑相同 (不大於 BALL_SIZE / 2)
+} BallView;
+
+// 均勻格子 (陣列由呼叫端提供，覆蓋 [0, cols * BALL_SIZE) x [0, rows * BALL_SIZE)，範圍外的球歸入邊緣的格子)
+typedef struct BallGrid {
+    int cols, rows;
+    uint32_t* cellStart; // cols * rows + 1 個：格子 c 的球為 items[cellStart[c], cellStart[c + 1])
+    uint32_t* items; // count 個：依格子排序的球索引
+    uint32_t* cellOf; // count 個：各球所在的格子
+} BallGrid;
+
+// 世界中的多球 (SoA，屬於 GameWorld 的模擬狀態)
+// 欄位 0 保留給主球：碰撞前由 gWorld->ball 複製進來，碰撞後寫回，其餘模組仍只讀寫 gWorld->ball。
+typedef struct Multiball {
+    RVec2 pos[MULTIBALL_MAX];
+    RVec2 dir[MULTIBALL_MAX];
+    Real speed[MULTIBALL_MAX];
+    int count; // 含主球 (1 表示沒有額外的球)
+} Multiball;
+
+// 世界中的碰撞格子 (屬於 GameWorld 但不是模擬狀態，快照不保存)
+typedef struct MultiballGrid {
+    uint32_t cellStart[BALL_GRID_CELLS + 1];
+    uint32_t items[MULTIBALL_MAX];
+    uint32_t cellOf[MULTIBALL_MAX];
+} MultiballGrid;
+
+void MultiballSetCount(int extra); // 每局額外的球數 (所有世界共用，只在建立世界之前設定，0 表示關閉多球模式)
+void MultiballReset(); // 重設目前世界的額外球 (排成一列向上散開)
+void MultiballUpdate(); // 移動額外的球並解決所有球之間的碰撞 (在 BallUpdate 之後呼叫)
+void MultiballHandleEvents(); // 批次處理本幀事件：主球掉落時重設
+void MultiballRender(RenderFrame* f); // 將額外的球加入繪製清單
+StateBlock MultiballStateBlock(); // 多球的模擬狀態 (快照用)
+uint64_t MultiballStateHash(uint64_t h); // 將額外的球累加進雜湊值
+void MultiballNearest(const RVec2* query, int n, RVec2* out); // 各查詢點最近的球 (含主球) 的位置
+uint32_t BallCollide(BallView v, BallGrid g, uint32_t* pairs); // 建立格子並解決重疊的球，返回接觸數 (pairs 累加測試的球對數，可為 NULL)
+
+#endif
@@ -0,0 +1,212 @@
+#include "nearest.h"
+#include <math.h>
+
+#define NEAREST_MAX_K 32 // NearestKnn 一次最多返回的點數
+
+static int ClampCell(int c, int n)
+{
+    return c < 0 ? 0 : (c >= n ? n - 1 : c);
+}
+
+static inline int NearestCellX(const NearestIndex* ix, Real x)
+{
+    return ClampCell(RFloorInt(x - ix->originX) / ix->cellSize, ix->cols);
+}
+
+static inline int NearestCellY(const NearestIndex* ix, Real y)
+{
+    return ClampCell(RFloorInt(y - ix->originY) / ix->cellSize, ix->rows);
+}
+
+// 整數平方根 (向下取整)，以整數修正浮點數的估計值，結果與平台無關
+static int ISqrt(long a)
+{
+    long r = (long)sqrt((double)a);
+    while (r > 0 && r * r > a) {
+        r--;
+    }
+    while ((r + 1) * (r + 1) <= a) {
+        r++;
+    }
+    return (int)r;
+}
+
+/**
+ * @brief 由位置陣列建立查詢索引 (O(n + 格子數))
+ *
+ * @param ix 要建立的索引
+ * @param pos 位置陣列 (查詢期間不可改變)
+ * @param count 點數
+ * @param cellStart 容量 NEAREST_MAX_CELLS(count) + 1
+ * @param items 容量 count
+ * @param cellOf 容量 count 的暫存
+ */
+void NearestBuild(NearestIndex* ix, const RVec2* pos, int count, uint32_t* cellStart, uint32_t* items, uint32_t* cellOf)
+{
+    *ix = (NearestIndex) { .pos = pos, .count = count, .cellSize = 1, .cols = 1, .rows = 1, .cellStart = cellStart, .items = items };
+    if (count <= 0) {
+        cellStart[0] = cellStart[1] = 0;
+        return;
+    }
+    Real minX = pos[0].x, maxX = pos[0].x, minY = pos[0].y, maxY = pos[0].y;
+    for (int i = 1; i < count; i++) {
+        minX = pos[i].x < minX ? pos[i].x : minX;
+        maxX = pos[i].x > maxX ? pos[i].x : maxX;
+        minY = pos[i].y < minY ? pos[i].y : minY;
+        maxY = pos[i].y > maxY ? pos[i].y : maxY;
+    }
+    int w = RFloorInt(maxX - minX) + 1; // 外框的像素尺寸
+    int h = RFloorInt(maxY - minY) + 1;
+    int maxCells = NEAREST_MAX_CELLS(count);
+    int cell = ISqrt((long)w * h / maxCells);
+    cell = cell < 1 ? 1 : cell;
+    int cols, rows;
+    for (;;) { // 外框細長時格子數可能超出上限，加大格子直到放得下
+        cols = (w + cell - 1) / cell;
+        rows = (h + cell - 1) / cell;
+        if ((long)cols * rows <= maxCells) {
+            break;
+        }
+        cell += cell / 8 + 1;
+    }
+    ix->originX = minX;
+    ix->originY = minY;
+    ix->cellSize = cell;
+    ix->cols = cols;
+    ix->rows = rows;
+    int cells = cols * rows;
+    for (int c = 0; c <= cells; c++) {
+        cellStart[c] = 0;
+    }
+    for (int i = 0; i < count; i++) {
+        uint32_t c = (uint32_t)(NearestCellY(ix, pos[i].y) * cols + NearestCellX(ix, pos[i].x));
+        cellOf[i] = c;
+        cellStart[c]++;
+    }
+    for (int c = 1; c <= cells; c++) { // cellStart[c] 成為格子 c 的結尾
+        cellStart[c] += cellStart[c - 1];
+    }
+    for (int i = count - 1; i >= 0; i--) { // 放入後 cellStart[c] 退回格子 c 的開頭，同一格子中維持索引順序
+        items[--cellStart[cellOf[i]]] = (uint32_t)i;
+    }
+}
+
+/**
+ * @brief 最近的 k 個點 (距離相同時索引較小者優先)
+ * 由查詢點所在的格子向外逐圈搜尋；第 r 圈的格子與查詢點至少相距 (r - 1) 個格子，
+ * 已找到 k 個點且第 k 個的距離不大於此值時停止。
+ *
+ * @param maxDist 只返回距離不超過此值的點
+ * @param out 依距離排序的點索引 (容量 k，k 超過 NEAREST_MAX_K 時截斷)
+ * @return 找到的數量
+ */
+int NearestKnn(const NearestIndex* ix, RVec2 p, int k, Real maxDist, uint32_t* out)
+{
+    if (ix->count <= 0 || k <= 0) {
+        return 0;
+    }
+    k = k > NEAREST_MAX_K ? NEAREST_MAX_K : k;
+    RealWide dist[NEAREST_MAX_K];
+    RealWide limit = RMulWide(maxDist, maxDist);
+    int found = 0;
+    int cx = NearestCellX(ix, p.x);
+    int cy = NearestCellY(ix, p.y);
+    int rMax = cx;
+    rMax = ix->cols - 1 - cx > rMax ? ix->cols - 1 - cx : rMax;
+    rMax = cy > rMax ? cy : rMax;
+    rMax = ix->rows - 1 - cy > rMax ? ix->rows - 1 - cy : rMax;
+    for (int r = 0; r <= rMax; r++) {
+        if (r >= 2) {
+            Real gap = RFromInt((r - 1) * ix->cellSize);
+            if (RMulWide(gap, gap) > (found == k ? dist[k - 1] : limit)) {
+                break;
+            }
+        }
+        for (int y = cy - r; y <= cy + r; y++) {
+            if (y < 0 || y >= ix->rows) {
+                continue;
+            }
+            int step = (r == 0 || y == cy - r || y == cy + r) ? 1 : 2 * r; // 中間的列只有左右兩端屬於這一圈
+            for (int x = cx - r; x <= cx + r; x += step) {
+                if (x < 0 || x >= ix->cols) {
+                    continue;
+                }
+                int c = y * ix->cols + x;
+                for (uint32_t m = ix->cellStart[c]; m < ix->cellStart[c + 1]; m++) {
+                    uint32_t idx = ix->items[m];
+                    RealWide d2 = RVec2DistanceSqr(ix->pos[idx], p);
+                    if (d2 > limit) {
+                        continue;
+                    }
+                    if (found == k && !(d2 < dist[k - 1] || (d2 == dist[k - 1] && idx < out[k - 1]))) {
+                        continue;
+                    }
+                    int j = found < k ? found++ : k - 1; // 插入排序 (擠掉最遠的一個)
+                    while (j > 0 && (d2 < dist[j - 1] || (d2 == dist[j - 1] && idx < out[j - 1]))) {
+                        dist[j] = dist[j - 1];
+                        out[j] = out[j - 1];
+                        j--;
+                    }
+                    dist[j] = d2;
+                    out[j] = idx;
+                }
+            }
+        }
+    }
+    return found;
+}
+
+/**
+ * @brief 距離不超過 maxDist 的最近點
+ *
+ * @return 點索引，沒有時返回 -1
+ */
+int NearestQuery(const NearestIndex* ix, RVec2 p, Real maxDist)
+{
+    uint32_t idx;
+    return NearestKnn(ix, p, 1, maxDist, &idx) > 0 ? (int)idx : -1;
+}
+
+/**
+ * @brief 距離不超過 radius 的所有點 (依格子順序)
+ *
+ * @param out 點索引 (最多寫入 max 個)
+ * @return 符合的總數 (可能大於 max)
+ */
+int NearestRadius(const NearestIndex* ix, RVec2 p, Real radius, uint32_t* out, int max)
+{
+    if (ix->count <= 0) {
+        return 0;
+    }
+    RealWide r2 = RMulWide(radius, radius);
+    int x0 = NearestCellX(ix, p.x - radius), x1 = NearestCellX(ix, p.x + radius);
+    int y0 = NearestCellY(ix, p.y - radius), y1 = NearestCellY(ix, p.y + radius);
+    int n = 0;
+    for (int y = y0; y <= y1; y++) {
+        for (int x = x0; x <= x1; x++) {
+            int c = y * ix->cols + x;
+            for (uint32_t m = ix->cellStart[c]; m < ix->cellStart[c + 1]; m++) {
+                uint32_t idx = ix->items[m];
+                if (RVec2DistanceSqr(ix->pos[idx], p) <= r2) {
+                    if (n < max) {
+                        out[n] = idx;
+                    }
+                    n++;
+                }
+            }
+        }
+    }
+    return n;
+}
+
+/**
+ * @brief 一次回答 n 個最近鄰查詢 (例如所有追蹤中的敵人)
+ *
+ * @param out 各查詢的最近點索引，沒有時為 -1
+ */
+void NearestBatch(const NearestIndex* ix, const RVec2* query, int n, Real maxDist, int32_t* out)
+{
+    for (int i = 0; i < n; i++) {
+        out[i] = NearestQuery(ix, query[i], maxDist);
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef __NEAREST_H__
+#define __NEAREST_H__
+#include "real.h"
+#include <stdint.h>
+
+// 最近鄰與半徑查詢的索引 (追蹤最近的球等行為)
+// 每個 tick 由 SoA 的位置陣列以計數排序建立均勻格子 (O(n))：格子覆蓋所有點的外框，
+// 格子大小 (整數像素) 依外框面積選擇，使每格平均約 NEAREST_POINTS_PER_CELL 個點。
+// 最近鄰查詢由查詢點所在的格子向外一圈一圈搜尋，找到的距離不大於下一圈的最小可能距離時停止。
+// 距離相同時索引較小者優先，結果與搜尋順序無關。
+
+#define NEAREST_POINTS_PER_CELL 2 // 每格的平均點數
+#define NEAREST_MAX_CELLS(n) ((n) / NEAREST_POINTS_PER_CELL + 1) // n 個點的格子數上限 (cellStart 需要再多 1 個)
+
+// 查詢索引 (陣列屬於呼叫端；建立後位置陣列不可改變)
+typedef struct NearestIndex {
+    const RVec2* pos; // 建立時的位置陣列
+    int count;
+    Real originX, originY; // 格子 (0, 0) 的左上角 (外框的左上角)
+    int cellSize; // 格子大小 (像素)
+    int cols, rows;
+    uint32_t* cellStart; // cols * rows + 1 個：格子 c 的點為 items[cellStart[c], cellStart[c + 1])
+    uint32_t* items; // count 個：依格子排序的點索引
+} NearestIndex;
+
+void NearestBuild(NearestIndex* ix, const RVec2* pos, int count, uint32_t* cellStart, uint32_t* items, uint32_t* cellOf); // cellStart 容量 NEAREST_MAX_CELLS(count) + 1，cellOf 為 count 個的暫存
+int NearestQuery(const NearestIndex* ix, RVec2 p, Real maxDist); // 距離不超過 maxDist 的最近點，沒有時返回 -1
+int NearestKnn(const NearestIndex* ix, RVec2 p, int k, Real maxDist, uint32_t* out); // 最近的 k 個點 (依距離排序)，返回找到的數量
+int NearestRadius(const NearestIndex* ix, RVec2 p, Real radius, uint32_t* out, int max); // 距離不超過 radius 的所有點 (最多寫入 max 個)，返回總數
+void NearestBatch(const NearestIndex* ix, const RVec2* query, int n, Real maxDist, int32_t* out); // 一次回答 n 個最近鄰查詢
+
+#endif
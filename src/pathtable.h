@@ -0,0 +1,1144 @@
+// 由 tools/pathgen.c 產生 (nob.c 建置時自動更新)，請勿手動修改
+// 宣告部分由 enemy.h 引入；定義 PATHTABLE_IMPLEMENTATION 後引入則輸出路徑表 (只在 enemy.c)
+#ifndef __PATHTABLE_H__
+#define __PATHTABLE_H__
+
+#define PATH_COUNT 5 // 路徑數量
+#define PATH_MAX_POINTS 72 // 最長路徑的點數
+
+#endif
+
+#ifdef PATHTABLE_IMPLEMENTATION
+const EnemyPath enemyPath[PATH_COUNT] = {
+    { // 0: 原始的繞行路徑
+        .points = {
+            { R(720.0000f), R(180.0000f) },
+            { R(645.1342f), R(153.9528f) },
+            { R(455.5674f), R(128.6970f) },
+            { R(240.0000f), R(105.0000f) },
+            { R(99.2984f), R(83.5819f) },
+            { R(99.2984f), R(65.0933f) },
+            { R(240.0000f), R(50.0962f) },
+            { R(455.5674f), R(39.0461f) },
+            { R(645.1342f), R(32.2788f) },
+            { R(720.0000f), R(30.0000f) },
+            { R(645.1342f), R(32.2788f) },
+            { R(455.5674f), R(39.0461f) },
+            { R(240.0000f), R(50.0962f) },
+            { R(99.2984f), R(65.0933f) },
+            { R(99.2984f), R(83.5819f) },
+            { R(240.0000f), R(105.0000f) },
+            { R(455.5674f), R(128.6970f) },
+            { R(645.1342f), R(153.9528f) },
+            { R(720.0000f), R(180.0000f) },
+            { R(645.1342f), R(206.0472f) },
+            { R(455.5674f), R(231.3030f) },
+            { R(240.0000f), R(255.0000f) },
+            { R(99.2984f), R(276.4181f) },
+            { R(99.2984f), R(294.9067f) },
+            { R(240.0000f), R(309.9038f) },
+            { R(455.5674f), R(320.9539f) },
+            { R(645.1342f), R(327.7212f) },
+            { R(720.0000f), R(330.0000f) },
+            { R(645.1342f), R(327.7212f) },
+            { R(455.5674f), R(320.9539f) },
+            { R(240.0000f), R(309.9038f) },
+            { R(99.2984f), R(294.9067f) },
+            { R(99.2984f), R(276.4181f) },
+            { R(240.0000f), R(255.0000f) },
+            { R(455.5674f), R(231.3030f) },
+            { R(645.1342f), R(206.0472f) },
+            { R(720.0000f), R(180.0000f) },
+            { R(645.1342f), R(153.9528f) },
+            { R(455.5674f), R(128.6970f) },
+            { R(240.0000f), R(105.0000f) },
+            { R(99.2984f), R(83.5819f) },
+            { R(99.2984f), R(65.0933f) },
+            { R(240.0000f), R(50.0962f) },
+            { R(455.5674f), R(39.0461f) },
+            { R(645.1342f), R(32.2788f) },
+            { R(720.0000f), R(30.0000f) },
+            { R(645.1342f), R(32.2788f) },
+            { R(455.5674f), R(39.0461f) },
+            { R(240.0000f), R(50.0962f) },
+            { R(99.2984f), R(65.0933f) },
+            { R(99.2984f), R(83.5819f) },
+            { R(240.0000f), R(105.0000f) },
+            { R(455.5674f), R(128.6970f) },
+            { R(645.1342f), R(153.9528f) },
+            { R(720.0000f), R(180.0000f) },
+            { R(645.1342f), R(206.0472f) },
+            { R(455.5674f), R(231.3030f) },
+            { R(240.0000f), R(255.0000f) },
+            { R(99.2984f), R(276.4181f) },
+            { R(99.2984f), R(294.9067f) },
+            { R(240.0000f), R(309.9038f) },
+            { R(455.5674f), R(320.9539f) },
+            { R(645.1342f), R(327.7212f) },
+            { R(720.0000f), R(330.0000f) },
+            { R(645.1342f), R(327.7212f) },
+            { R(455.5674f), R(320.9539f) },
+            { R(240.0000f), R(309.9038f) },
+            { R(99.2984f), R(294.9067f) },
+            { R(99.2984f), R(276.4181f) },
+            { R(240.0000f), R(255.0000f) },
+            { R(455.5674f), R(231.3030f) },
+            { R(645.1342f), R(206.0472f) },
+        },
+        .tangent = {
+            { R(-0.944470f), R(-0.328599f) },
+            { R(-0.991241f), R(-0.132062f) },
+            { R(-0.994012f), R(-0.109270f) },
+            { R(-0.988611f), R(-0.150490f) },
+            { R(0.000000f), R(-1.000000f) },
+            { R(0.994367f), R(-0.105988f) },
+            { R(0.998689f), R(-0.051193f) },
+            { R(0.999363f), R(-0.035676f) },
+            { R(0.999537f), R(-0.030425f) },
+            { R(-0.999537f), R(0.030425f) },
+            { R(-0.999363f), R(0.035676f) },
+            { R(-0.998689f), R(0.051193f) },
+            { R(-0.994367f), R(0.105988f) },
+            { R(0.000000f), R(1.000000f) },
+            { R(0.988611f), R(0.150490f) },
+            { R(0.994012f), R(0.109270f) },
+            { R(0.991241f), R(0.132062f) },
+            { R(0.944470f), R(0.328599f) },
+            { R(-0.944470f), R(0.328599f) },
+            { R(-0.991241f), R(0.132062f) },
+            { R(-0.994012f), R(0.109270f) },
+            { R(-0.988611f), R(0.150490f) },
+            { R(0.000000f), R(1.000000f) },
+            { R(0.994367f), R(0.105988f) },
+            { R(0.998689f), R(0.051193f) },
+            { R(0.999363f), R(0.035676f) },
+            { R(0.999537f), R(0.030425f) },
+            { R(-0.999537f), R(-0.030425f) },
+            { R(-0.999363f), R(-0.035676f) },
+            { R(-0.998689f), R(-0.051193f) },
+            { R(-0.994367f), R(-0.105988f) },
+            { R(0.000000f), R(-1.000000f) },
+            { R(0.988611f), R(-0.150490f) },
+            { R(0.994012f), R(-0.109270f) },
+            { R(0.991241f), R(-0.132062f) },
+            { R(0.944470f), R(-0.328599f) },
+            { R(-0.944470f), R(-0.328599f) },
+            { R(-0.991241f), R(-0.132062f) },
+            { R(-0.994012f), R(-0.109270f) },
+            { R(-0.988611f), R(-0.150490f) },
+            { R(0.000000f), R(-1.000000f) },
+            { R(0.994367f), R(-0.105988f) },
+            { R(0.998689f), R(-0.051193f) },
+            { R(0.999363f), R(-0.035676f) },
+            { R(0.999537f), R(-0.030425f) },
+            { R(-0.999537f), R(0.030425f) },
+            { R(-0.999363f), R(0.035676f) },
+            { R(-0.998689f), R(0.051193f) },
+            { R(-0.994367f), R(0.105988f) },
+            { R(0.000000f), R(1.000000f) },
+            { R(0.988611f), R(0.150490f) },
+            { R(0.994012f), R(0.109270f) },
+            { R(0.991241f), R(0.132062f) },
+            { R(0.944470f), R(0.328599f) },
+            { R(-0.944470f), R(0.328599f) },
+            { R(-0.991241f), R(0.132062f) },
+            { R(-0.994012f), R(0.109270f) },
+            { R(-0.988611f), R(0.150490f) },
+            { R(0.000000f), R(1.000000f) },
+            { R(0.994367f), R(0.105988f) },
+            { R(0.998689f), R(0.051193f) },
+            { R(0.999363f), R(0.035676f) },
+            { R(0.999537f), R(0.030425f) },
+            { R(-0.999537f), R(-0.030425f) },
+            { R(-0.999363f), R(-0.035676f) },
+            { R(-0.998689f), R(-0.051193f) },
+            { R(-0.994367f), R(-0.105988f) },
+            { R(0.000000f), R(-1.000000f) },
+            { R(0.988611f), R(-0.150490f) },
+            { R(0.994012f), R(-0.109270f) },
+            { R(0.991241f), R(-0.132062f) },
+            { R(0.944470f), R(-0.328599f) },
+        },
+        .arcLength = {
+            R(0.0f),
+            R(79.2675f),
+            R(270.5093f),
+            R(487.3753f),
+            R(629.6978f),
+            R(648.1863f),
+            R(789.6850f),
+            R(1005.5354f),
+            R(1195.2230f),
+            R(1270.1234f),
+            R(1345.0239f),
+            R(1534.7114f),
+            R(1750.5619f),
+            R(1892.0605f),
+            R(1910.5491f),
+            R(2052.8715f),
+            R(2269.7375f),
+            R(2460.9793f),
+            R(2540.2469f),
+            R(2619.5144f),
+            R(2810.7562f),
+            R(3027.6222f),
+            R(3169.9447f),
+            R(3188.4332f),
+            R(3329.9319f),
+            R(3545.7823f),
+            R(3735.4699f),
+            R(3810.3703f),
+            R(3885.2708f),
+            R(4074.9583f),
+            R(4290.8088f),
+            R(4432.3074f),
+            R(4450.7959f),
+            R(4593.1184f),
+            R(4809.9844f),
+            R(5001.2262f),
+            R(5080.4938f),
+            R(5159.7613f),
+            R(5351.0031f),
+            R(5567.8691f),
+            R(5710.1916f),
+            R(5728.6801f),
+            R(5870.1787f),
+            R(6086.0292f),
+            R(6275.7167f),
+            R(6350.6172f),
+            R(6425.5176f),
+            R(6615.2052f),
+            R(6831.0557f),
+            R(6972.5543f),
+            R(6991.0428f),
+            R(7133.3653f),
+            R(7350.2313f),
+            R(7541.4731f),
+            R(7620.7406f),
+            R(7700.0082f),
+            R(7891.2500f),
+            R(8108.1160f),
+            R(8250.4385f),
+            R(8268.9270f),
+            R(8410.4256f),
+            R(8626.2761f),
+            R(8815.9636f),
+            R(8890.8641f),
+            R(8965.7645f),
+            R(9155.4521f),
+            R(9371.3025f),
+            R(9512.8012f),
+            R(9531.2897f),
+            R(9673.6122f),
+            R(9890.4782f),
+            R(10081.7200f),
+            R(10160.9875f),
+        },
+        .pointCount = 72,
+    },
+    { // 1: 左上角的小圓形軌道
+        .points = {
+            { R(300.0000f), R(150.0000f) },
+            { R(227.5637f), R(246.1262f) },
+            { R(115.1952f), R(202.9919f) },
+            { R(125.6855f), R(83.0869f) },
+            { R(243.8371f), R(60.1206f) },
+            { R(298.4808f), R(167.3648f) },
+            { R(210.4528f), R(249.4522f) },
+            { R(107.2816f), R(187.4607f) },
+            { R(138.4339f), R(71.1989f) },
+            { R(258.7785f), R(69.0983f) },
+            { R(293.9693f), R(184.2020f) },
+            { R(193.0244f), R(249.7564f) },
+            { R(102.1852f), R(170.7912f) },
+            { R(153.0528f), R(61.7052f) },
+            { R(271.9340f), R(80.5342f) },
+            { R(286.6025f), R(200.0000f) },
+            { R(175.8078f), R(247.0296f) },
+            { R(100.0609f), R(153.4899f) },
+            { R(169.0983f), R(54.8943f) },
+            { R(282.9038f), R(94.0807f) },
+            { R(276.6044f), R(214.2788f) },
+            { R(159.3263f), R(241.3545f) },
+            { R(100.9732f), R(136.0827f) },
+            { R(186.0827f), R(50.9732f) },
+            { R(291.3545f), R(109.3263f) },
+            { R(264.2788f), R(226.6044f) },
+            { R(144.0807f), R(232.9038f) },
+            { R(104.8943f), R(119.0983f) },
+            { R(203.4899f), R(50.0609f) },
+            { R(297.0296f), R(125.8078f) },
+            { R(250.0000f), R(236.6025f) },
+            { R(130.5342f), R(221.9340f) },
+            { R(111.7052f), R(103.0528f) },
+            { R(220.7912f), R(52.1852f) },
+            { R(299.7564f), R(143.0244f) },
+            { R(234.2020f), R(243.9693f) },
+            { R(119.0983f), R(208.7785f) },
+            { R(121.1989f), R(88.4339f) },
+            { R(237.4607f), R(57.2816f) },
+            { R(299.4522f), R(160.4528f) },
+            { R(217.3648f), R(248.4808f) },
+            { R(110.1206f), R(193.8371f) },
+            { R(133.0869f), R(75.6855f) },
+            { R(252.9919f), R(65.1952f) },
+            { R(296.1262f), R(177.5637f) },
+            { R(200.0000f), R(250.0000f) },
+            { R(103.8738f), R(177.5637f) },
+            { R(147.0081f), R(65.1952f) },
+            { R(266.9131f), R(75.6855f) },
+            { R(289.8794f), R(193.8371f) },
+            { R(182.6352f), R(248.4808f) },
+            { R(100.5478f), R(160.4528f) },
+            { R(162.5393f), R(57.2816f) },
+            { R(278.8011f), R(88.4339f) },
+            { R(280.9017f), R(208.7785f) },
+            { R(165.7980f), R(243.9693f) },
+            { R(100.2436f), R(143.0244f) },
+            { R(179.2088f), R(52.1852f) },
+            { R(288.2948f), R(103.0528f) },
+            { R(269.4658f), R(221.9340f) },
+            { R(150.0000f), R(236.6025f) },
+            { R(102.9704f), R(125.8078f) },
+            { R(196.5101f), R(50.0609f) },
+            { R(295.1057f), R(119.0983f) },
+            { R(255.9193f), R(232.9038f) },
+            { R(135.7212f), R(226.6044f) },
+            { R(108.6455f), R(109.3263f) },
+            { R(213.9173f), R(50.9732f) },
+            { R(299.0268f), R(136.0827f) },
+            { R(240.6737f), R(241.3545f) },
+            { R(123.3956f), R(214.2788f) },
+            { R(117.0962f), R(94.0807f) },
+        },
+        .tangent = {
+            { R(-0.601815f), R(0.798636f) },
+            { R(-0.933580f), R(-0.358368f) },
+            { R(0.087156f), R(-0.996195f) },
+            { R(0.981627f), R(-0.190809f) },
+            { R(0.453990f), R(0.891007f) },
+            { R(-0.731354f), R(0.681998f) },
+            { R(-0.857167f), R(-0.515038f) },
+            { R(0.258819f), R(-0.965926f) },
+            { R(0.999848f), R(-0.017452f) },
+            { R(0.292372f), R(0.956305f) },
+            { R(-0.838671f), R(0.544639f) },
+            { R(-0.754710f), R(-0.656059f) },
+            { R(0.422618f), R(-0.906308f) },
+            { R(0.987688f), R(0.156434f) },
+            { R(0.121869f), R(0.992546f) },
+            { R(-0.920505f), R(0.390731f) },
+            { R(-0.629320f), R(-0.777146f) },
+            { R(0.573576f), R(-0.819152f) },
+            { R(0.945519f), R(0.325568f) },
+            { R(-0.052336f), R(0.998630f) },
+            { R(-0.974370f), R(0.224951f) },
+            { R(-0.484810f), R(-0.874620f) },
+            { R(0.707107f), R(-0.707107f) },
+            { R(0.874620f), R(0.484810f) },
+            { R(-0.224951f), R(0.974370f) },
+            { R(-0.998630f), R(0.052336f) },
+            { R(-0.325568f), R(-0.945519f) },
+            { R(0.819152f), R(-0.573576f) },
+            { R(0.777146f), R(0.629320f) },
+            { R(-0.390731f), R(0.920505f) },
+            { R(-0.992546f), R(-0.121869f) },
+            { R(-0.156434f), R(-0.987688f) },
+            { R(0.906308f), R(-0.422618f) },
+            { R(0.656059f), R(0.754710f) },
+            { R(-0.544639f), R(0.838671f) },
+            { R(-0.956305f), R(-0.292372f) },
+            { R(0.017452f), R(-0.999848f) },
+            { R(0.965926f), R(-0.258819f) },
+            { R(0.515038f), R(0.857167f) },
+            { R(-0.681998f), R(0.731354f) },
+            { R(-0.891007f), R(-0.453990f) },
+            { R(0.190809f), R(-0.981627f) },
+            { R(0.996195f), R(-0.087156f) },
+            { R(0.358368f), R(0.933580f) },
+            { R(-0.798636f), R(0.601815f) },
+            { R(-0.798636f), R(-0.601815f) },
+            { R(0.358368f), R(-0.933580f) },
+            { R(0.996195f), R(0.087156f) },
+            { R(0.190809f), R(0.981627f) },
+            { R(-0.891007f), R(0.453990f) },
+            { R(-0.681998f), R(-0.731354f) },
+            { R(0.515038f), R(-0.857167f) },
+            { R(0.965926f), R(0.258819f) },
+            { R(0.017452f), R(0.999848f) },
+            { R(-0.956305f), R(0.292372f) },
+            { R(-0.544639f), R(-0.838671f) },
+            { R(0.656059f), R(-0.754710f) },
+            { R(0.906308f), R(0.422618f) },
+            { R(-0.156434f), R(0.987688f) },
+            { R(-0.992546f), R(0.121869f) },
+            { R(-0.390731f), R(-0.920505f) },
+            { R(0.777146f), R(-0.629320f) },
+            { R(0.819152f), R(0.573576f) },
+            { R(-0.325568f), R(0.945519f) },
+            { R(-0.998630f), R(-0.052336f) },
+            { R(-0.224951f), R(-0.974370f) },
+            { R(0.874620f), R(-0.484810f) },
+            { R(0.707107f), R(0.707107f) },
+            { R(-0.484810f), R(0.874620f) },
+            { R(-0.974370f), R(-0.224951f) },
+            { R(-0.052336f), R(-0.998630f) },
+            { R(0.956305f), R(0.292372f) },
+        },
+        .arcLength = {
+            R(0.0f),
+            R(120.3630f),
+            R(240.7260f),
+            R(361.0890f),
+            R(481.4520f),
+            R(601.8150f),
+            R(722.1780f),
+            R(842.5410f),
+            R(962.9040f),
+            R(1083.2670f),
+            R(1203.6300f),
+            R(1323.9931f),
+            R(1444.3561f),
+            R(1564.7191f),
+            R(1685.0821f),
+            R(1805.4451f),
+            R(1925.8081f),
+            R(2046.1711f),
+            R(2166.5341f),
+            R(2286.8971f),
+            R(2407.2601f),
+            R(2527.6231f),
+            R(2647.9861f),
+            R(2768.3491f),
+            R(2888.7121f),
+            R(3009.0751f),
+            R(3129.4381f),
+            R(3249.8011f),
+            R(3370.1641f),
+            R(3490.5271f),
+            R(3610.8901f),
+            R(3731.2531f),
+            R(3851.6161f),
+            R(3971.9792f),
+            R(4092.3422f),
+            R(4212.7052f),
+            R(4333.0682f),
+            R(4453.4312f),
+            R(4573.7942f),
+            R(4694.1572f),
+            R(4814.5202f),
+            R(4934.8832f),
+            R(5055.2462f),
+            R(5175.6092f),
+            R(5295.9722f),
+            R(5416.3352f),
+            R(5536.6982f),
+            R(5657.0612f),
+            R(5777.4242f),
+            R(5897.7872f),
+            R(6018.1502f),
+            R(6138.5132f),
+            R(6258.8762f),
+            R(6379.2392f),
+            R(6499.6023f),
+            R(6619.9653f),
+            R(6740.3283f),
+            R(6860.6913f),
+            R(6981.0543f),
+            R(7101.4173f),
+            R(7221.7803f),
+            R(7342.1433f),
+            R(7462.5063f),
+            R(7582.8693f),
+            R(7703.2323f),
+            R(7823.5953f),
+            R(7943.9583f),
+            R(8064.3213f),
+            R(8184.6843f),
+            R(8305.0473f),
+            R(8425.4103f),
+            R(8545.7733f),
+            R(8737.0343f),
+        },
+        .pointCount = 72,
+    },
+    { // 2: 畫面中央上部的長條橢圓
+        .points = {
+            { R(700.0000f), R(120.0000f) },
+            { R(689.7777f), R(94.1181f) },
+            { R(659.8076f), R(70.0000f) },
+            { R(612.1320f), R(49.2893f) },
+            { R(550.0000f), R(33.3975f) },
+            { R(477.6457f), R(23.4074f) },
+            { R(400.0000f), R(20.0000f) },
+            { R(322.3543f), R(23.4074f) },
+            { R(250.0000f), R(33.3975f) },
+            { R(187.8680f), R(49.2893f) },
+            { R(140.1924f), R(70.0000f) },
+            { R(110.2223f), R(94.1181f) },
+            { R(100.0000f), R(120.0000f) },
+            { R(110.2223f), R(145.8819f) },
+            { R(140.1924f), R(170.0000f) },
+            { R(187.8680f), R(190.7107f) },
+            { R(250.0000f), R(206.6025f) },
+            { R(322.3543f), R(216.5926f) },
+            { R(400.0000f), R(220.0000f) },
+            { R(477.6457f), R(216.5926f) },
+            { R(550.0000f), R(206.6025f) },
+            { R(612.1320f), R(190.7107f) },
+            { R(659.8076f), R(170.0000f) },
+            { R(689.7777f), R(145.8819f) },
+            { R(700.0000f), R(120.0000f) },
+            { R(689.7777f), R(94.1181f) },
+            { R(659.8076f), R(70.0000f) },
+            { R(612.1320f), R(49.2893f) },
+            { R(550.0000f), R(33.3975f) },
+            { R(477.6457f), R(23.4074f) },
+            { R(400.0000f), R(20.0000f) },
+            { R(322.3543f), R(23.4074f) },
+            { R(250.0000f), R(33.3975f) },
+            { R(187.8680f), R(49.2893f) },
+            { R(140.1924f), R(70.0000f) },
+            { R(110.2223f), R(94.1181f) },
+            { R(100.0000f), R(120.0000f) },
+            { R(110.2223f), R(145.8819f) },
+            { R(140.1924f), R(170.0000f) },
+            { R(187.8680f), R(190.7107f) },
+            { R(250.0000f), R(206.6025f) },
+            { R(322.3543f), R(216.5926f) },
+            { R(400.0000f), R(220.0000f) },
+            { R(477.6457f), R(216.5926f) },
+            { R(550.0000f), R(206.6025f) },
+            { R(612.1320f), R(190.7107f) },
+            { R(659.8076f), R(170.0000f) },
+            { R(689.7777f), R(145.8819f) },
+            { R(700.0000f), R(120.0000f) },
+            { R(689.7777f), R(94.1181f) },
+            { R(659.8076f), R(70.0000f) },
+            { R(612.1320f), R(49.2893f) },
+            { R(550.0000f), R(33.3975f) },
+            { R(477.6457f), R(23.4074f) },
+            { R(400.0000f), R(20.0000f) },
+            { R(322.3543f), R(23.4074f) },
+            { R(250.0000f), R(33.3975f) },
+            { R(187.8680f), R(49.2893f) },
+            { R(140.1924f), R(70.0000f) },
+            { R(110.2223f), R(94.1181f) },
+            { R(100.0000f), R(120.0000f) },
+            { R(110.2223f), R(145.8819f) },
+            { R(140.1924f), R(170.0000f) },
+            { R(187.8680f), R(190.7107f) },
+            { R(250.0000f), R(206.6025f) },
+            { R(322.3543f), R(216.5926f) },
+            { R(400.0000f), R(220.0000f) },
+            { R(477.6457f), R(216.5926f) },
+            { R(550.0000f), R(206.6025f) },
+            { R(612.1320f), R(190.7107f) },
+            { R(659.8076f), R(170.0000f) },
+            { R(689.7777f), R(145.8819f) },
+        },
+        .tangent = {
+            { R(-0.367344f), R(-0.930085f) },
+            { R(-0.779065f), R(-0.626943f) },
+            { R(-0.917195f), R(-0.398437f) },
+            { R(-0.968812f), R(-0.247798f) },
+            { R(-0.990602f), R(-0.136774f) },
+            { R(-0.999038f), R(-0.043842f) },
+            { R(-0.999038f), R(0.043842f) },
+            { R(-0.990602f), R(0.136774f) },
+            { R(-0.968812f), R(0.247798f) },
+            { R(-0.917195f), R(0.398437f) },
+            { R(-0.779065f), R(0.626943f) },
+            { R(-0.367344f), R(0.930085f) },
+            { R(0.367344f), R(0.930085f) },
+            { R(0.779065f), R(0.626943f) },
+            { R(0.917195f), R(0.398437f) },
+            { R(0.968812f), R(0.247798f) },
+            { R(0.990602f), R(0.136774f) },
+            { R(0.999038f), R(0.043842f) },
+            { R(0.999038f), R(-0.043842f) },
+            { R(0.990602f), R(-0.136774f) },
+            { R(0.968812f), R(-0.247798f) },
+            { R(0.917195f), R(-0.398437f) },
+            { R(0.779065f), R(-0.626943f) },
+            { R(0.367344f), R(-0.930085f) },
+            { R(-0.367344f), R(-0.930085f) },
+            { R(-0.779065f), R(-0.626943f) },
+            { R(-0.917195f), R(-0.398437f) },
+            { R(-0.968812f), R(-0.247798f) },
+            { R(-0.990602f), R(-0.136774f) },
+            { R(-0.999038f), R(-0.043842f) },
+            { R(-0.999038f), R(0.043842f) },
+            { R(-0.990602f), R(0.136774f) },
+            { R(-0.968812f), R(0.247798f) },
+            { R(-0.917195f), R(0.398437f) },
+            { R(-0.779065f), R(0.626943f) },
+            { R(-0.367344f), R(0.930085f) },
+            { R(0.367344f), R(0.930085f) },
+            { R(0.779065f), R(0.626943f) },
+            { R(0.917195f), R(0.398437f) },
+            { R(0.968812f), R(0.247798f) },
+            { R(0.990602f), R(0.136774f) },
+            { R(0.999038f), R(0.043842f) },
+            { R(0.999038f), R(-0.043842f) },
+            { R(0.990602f), R(-0.136774f) },
+            { R(0.968812f), R(-0.247798f) },
+            { R(0.917195f), R(-0.398437f) },
+            { R(0.779065f), R(-0.626943f) },
+            { R(0.367344f), R(-0.930085f) },
+            { R(-0.367344f), R(-0.930085f) },
+            { R(-0.779065f), R(-0.626943f) },
+            { R(-0.917195f), R(-0.398437f) },
+            { R(-0.968812f), R(-0.247798f) },
+            { R(-0.990602f), R(-0.136774f) },
+            { R(-0.999038f), R(-0.043842f) },
+            { R(-0.999038f), R(0.043842f) },
+            { R(-0.990602f), R(0.136774f) },
+            { R(-0.968812f), R(0.247798f) },
+            { R(-0.917195f), R(0.398437f) },
+            { R(-0.779065f), R(0.626943f) },
+            { R(-0.367344f), R(0.930085f) },
+            { R(0.367344f), R(0.930085f) },
+            { R(0.779065f), R(0.626943f) },
+            { R(0.917195f), R(0.398437f) },
+            { R(0.968812f), R(0.247798f) },
+            { R(0.990602f), R(0.136774f) },
+            { R(0.999038f), R(0.043842f) },
+            { R(0.999038f), R(-0.043842f) },
+            { R(0.990602f), R(-0.136774f) },
+            { R(0.968812f), R(-0.247798f) },
+            { R(0.917195f), R(-0.398437f) },
+            { R(0.779065f), R(-0.626943f) },
+            { R(0.367344f), R(-0.930085f) },
+        },
+        .arcLength = {
+            R(0.0f),
+            R(27.8275f),
+            R(66.2968f),
+            R(118.2766f),
+            R(182.4088f),
+            R(255.4495f),
+            R(333.1699f),
+            R(410.8904f),
+            R(483.9311f),
+            R(548.0633f),
+            R(600.0430f),
+            R(638.5124f),
+            R(666.3398f),
+            R(694.1673f),
+            R(732.6366f),
+            R(784.6164f),
+            R(848.7486f),
+            R(921.7893f),
+            R(999.5097f),
+            R(1077.2302f),
+            R(1150.2709f),
+            R(1214.4031f),
+            R(1266.3828f),
+            R(1304.8522f),
+            R(1332.6796f),
+            R(1360.5071f),
+            R(1398.9765f),
+            R(1450.9562f),
+            R(1515.0884f),
+            R(1588.1291f),
+            R(1665.8496f),
+            R(1743.5700f),
+            R(1816.6107f),
+            R(1880.7429f),
+            R(1932.7227f),
+            R(1971.1920f),
+            R(1999.0195f),
+            R(2026.8469f),
+            R(2065.3163f),
+            R(2117.2960f),
+            R(2181.4282f),
+            R(2254.4689f),
+            R(2332.1894f),
+            R(2409.9098f),
+            R(2482.9505f),
+            R(2547.0827f),
+            R(2599.0625f),
+            R(2637.5318f),
+            R(2665.3593f),
+            R(2693.1867f),
+            R(2731.6561f),
+            R(2783.6358f),
+            R(2847.7681f),
+            R(2920.8088f),
+            R(2998.5292f),
+            R(3076.2496f),
+            R(3149.2903f),
+            R(3213.4226f),
+            R(3265.4023f),
+            R(3303.8717f),
+            R(3331.6991f),
+            R(3359.5266f),
+            R(3397.9959f),
+            R(3449.9757f),
+            R(3514.1079f),
+            R(3587.1486f),
+            R(3664.8690f),
+            R(3742.5895f),
+            R(3815.6302f),
+            R(3879.7624f),
+            R(3931.7421f),
+            R(3970.2115f),
+            R(3998.0389f),
+        },
+        .pointCount = 72,
+    },
+    { // 3: 畫面右側的直立橢圓
+        .points = {
+            { R(750.0000f), R(300.0000f) },
+            { R(740.6308f), R(194.3454f) },
+            { R(714.2788f), R(108.4889f) },
+            { R(675.8819f), R(58.5185f) },
+            { R(632.6352f), R(53.7981f) },
+            { R(592.6424f), R(95.2120f) },
+            { R(563.3975f), R(175.0000f) },
+            { R(550.3805f), R(278.2111f) },
+            { R(556.0307f), R(385.5050f) },
+            { R(579.2893f), R(476.7767f) },
+            { R(615.7980f), R(534.9232f) },
+            { R(658.7156f), R(549.0487f) },
+            { R(700.0000f), R(516.5064f) },
+            { R(731.9152f), R(443.3941f) },
+            { R(748.4808f), R(343.4120f) },
+            { R(746.5926f), R(235.2952f) },
+            { R(726.6044f), R(139.3031f) },
+            { R(692.2618f), R(73.4231f) },
+            { R(650.0000f), R(50.0000f) },
+            { R(607.7382f), R(73.4231f) },
+            { R(573.3956f), R(139.3031f) },
+            { R(553.4074f), R(235.2952f) },
+            { R(551.5192f), R(343.4120f) },
+            { R(568.0848f), R(443.3941f) },
+            { R(600.0000f), R(516.5064f) },
+            { R(641.2844f), R(549.0487f) },
+            { R(684.2020f), R(534.9232f) },
+            { R(720.7107f), R(476.7767f) },
+            { R(743.9693f), R(385.5050f) },
+            { R(749.6195f), R(278.2111f) },
+            { R(736.6025f), R(175.0000f) },
+            { R(707.3576f), R(95.2120f) },
+            { R(667.3648f), R(53.7981f) },
+            { R(624.1181f), R(58.5185f) },
+            { R(585.7212f), R(108.4889f) },
+            { R(559.3692f), R(194.3454f) },
+            { R(550.0000f), R(300.0000f) },
+            { R(559.3692f), R(405.6546f) },
+            { R(585.7212f), R(491.5111f) },
+            { R(624.1181f), R(541.4815f) },
+            { R(667.3648f), R(546.2019f) },
+            { R(707.3576f), R(504.7880f) },
+            { R(736.6025f), R(425.0000f) },
+            { R(749.6195f), R(321.7889f) },
+            { R(743.9693f), R(214.4950f) },
+            { R(720.7107f), R(123.2233f) },
+            { R(684.2020f), R(65.0768f) },
+            { R(641.2844f), R(50.9513f) },
+            { R(600.0000f), R(83.4936f) },
+            { R(568.0848f), R(156.6059f) },
+            { R(551.5192f), R(256.5880f) },
+            { R(553.4074f), R(364.7048f) },
+            { R(573.3956f), R(460.6969f) },
+            { R(607.7382f), R(526.5769f) },
+            { R(650.0000f), R(550.0000f) },
+            { R(692.2618f), R(526.5769f) },
+            { R(726.6044f), R(460.6969f) },
+            { R(746.5926f), R(364.7048f) },
+            { R(748.4808f), R(256.5880f) },
+            { R(731.9152f), R(156.6059f) },
+            { R(700.0000f), R(83.4936f) },
+            { R(658.7156f), R(50.9513f) },
+            { R(615.7980f), R(65.0768f) },
+            { R(579.2893f), R(123.2233f) },
+            { R(556.0307f), R(214.4950f) },
+            { R(550.3805f), R(321.7889f) },
+            { R(563.3975f), R(425.0000f) },
+            { R(592.6424f), R(504.7880f) },
+            { R(632.6352f), R(546.2019f) },
+            { R(675.8819f), R(541.4815f) },
+            { R(714.2788f), R(491.5111f) },
+            { R(740.6308f), R(405.6546f) },
+        },
+        .tangent = {
+            { R(-0.088331f), R(-0.996091f) },
+            { R(-0.293421f), R(-0.955983f) },
+            { R(-0.609293f), R(-0.792945f) },
+            { R(-0.994096f), R(-0.108508f) },
+            { R(-0.694657f), R(0.719341f) },
+            { R(-0.344144f), R(0.938917f) },
+            { R(-0.125128f), R(0.992141f) },
+            { R(0.052588f), R(0.998616f) },
+            { R(0.246937f), R(0.969032f) },
+            { R(0.531748f), R(0.846902f) },
+            { R(0.949874f), R(0.312633f) },
+            { R(0.785351f), R(-0.619051f) },
+            { R(0.400067f), R(-0.916486f) },
+            { R(0.163457f), R(-0.986550f) },
+            { R(-0.017462f), R(-0.999848f) },
+            { R(-0.203854f), R(-0.979001f) },
+            { R(-0.462253f), R(-0.886748f) },
+            { R(-0.874647f), R(-0.484761f) },
+            { R(-0.874647f), R(0.484761f) },
+            { R(-0.462253f), R(0.886748f) },
+            { R(-0.203854f), R(0.979001f) },
+            { R(-0.017462f), R(0.999848f) },
+            { R(0.163457f), R(0.986550f) },
+            { R(0.400067f), R(0.916486f) },
+            { R(0.785351f), R(0.619051f) },
+            { R(0.949874f), R(-0.312633f) },
+            { R(0.531748f), R(-0.846902f) },
+            { R(0.246937f), R(-0.969032f) },
+            { R(0.052588f), R(-0.998616f) },
+            { R(-0.125128f), R(-0.992141f) },
+            { R(-0.344144f), R(-0.938917f) },
+            { R(-0.694657f), R(-0.719341f) },
+            { R(-0.994096f), R(0.108508f) },
+            { R(-0.609293f), R(0.792945f) },
+            { R(-0.293421f), R(0.955983f) },
+            { R(-0.088331f), R(0.996091f) },
+            { R(0.088331f), R(0.996091f) },
+            { R(0.293421f), R(0.955983f) },
+            { R(0.609293f), R(0.792945f) },
+            { R(0.994096f), R(0.108508f) },
+            { R(0.694657f), R(-0.719341f) },
+            { R(0.344144f), R(-0.938917f) },
+            { R(0.125128f), R(-0.992141f) },
+            { R(-0.052588f), R(-0.998616f) },
+            { R(-0.246937f), R(-0.969032f) },
+            { R(-0.531748f), R(-0.846902f) },
+            { R(-0.949874f), R(-0.312633f) },
+            { R(-0.785351f), R(0.619051f) },
+            { R(-0.400067f), R(0.916486f) },
+            { R(-0.163457f), R(0.986550f) },
+            { R(0.017462f), R(0.999848f) },
+            { R(0.203854f), R(0.979001f) },
+            { R(0.462253f), R(0.886748f) },
+            { R(0.874647f), R(0.484761f) },
+            { R(0.874647f), R(-0.484761f) },
+            { R(0.462253f), R(-0.886748f) },
+            { R(0.203854f), R(-0.979001f) },
+            { R(0.017462f), R(-0.999848f) },
+            { R(-0.163457f), R(-0.986550f) },
+            { R(-0.400067f), R(-0.916486f) },
+            { R(-0.785351f), R(-0.619051f) },
+            { R(-0.949874f), R(0.312633f) },
+            { R(-0.531748f), R(0.846902f) },
+            { R(-0.246937f), R(0.969032f) },
+            { R(-0.052588f), R(0.998616f) },
+            { R(0.125128f), R(0.992141f) },
+            { R(0.344144f), R(0.938917f) },
+            { R(0.694657f), R(0.719341f) },
+            { R(0.994096f), R(-0.108508f) },
+            { R(0.609293f), R(-0.792945f) },
+            { R(0.293421f), R(-0.955983f) },
+            { R(0.088331f), R(-0.996091f) },
+        },
+        .arcLength = {
+            R(0.0f),
+            R(106.0692f),
+            R(195.8788f),
+            R(258.8975f),
+            R(302.4011f),
+            R(359.9731f),
+            R(444.9519f),
+            R(548.9806f),
+            R(656.4232f),
+            R(750.6117f),
+            R(819.2695f),
+            R(864.4519f),
+            R(917.0201f),
+            R(996.7946f),
+            R(1098.1397f),
+            R(1206.2730f),
+            R(1304.3241f),
+            R(1378.6181f),
+            R(1426.9368f),
+            R(1475.2556f),
+            R(1549.5496f),
+            R(1647.6007f),
+            R(1755.7340f),
+            R(1857.0791f),
+            R(1936.8536f),
+            R(1989.4217f),
+            R(2034.6041f),
+            R(2103.2619f),
+            R(2197.4505f),
+            R(2304.8931f),
+            R(2408.9218f),
+            R(2493.9005f),
+            R(2551.4726f),
+            R(2594.9762f),
+            R(2657.9948f),
+            R(2747.8045f),
+            R(2853.8737f),
+            R(2959.9428f),
+            R(3049.7525f),
+            R(3112.7712f),
+            R(3156.2748f),
+            R(3213.8468f),
+            R(3298.8256f),
+            R(3402.8542f),
+            R(3510.2969f),
+            R(3604.4854f),
+            R(3673.1432f),
+            R(3718.3256f),
+            R(3770.8937f),
+            R(3850.6683f),
+            R(3952.0134f),
+            R(4060.1467f),
+            R(4158.1978f),
+            R(4232.4918f),
+            R(4280.8105f),
+            R(4329.1293f),
+            R(4403.4232f),
+            R(4501.4743f),
+            R(4609.6076f),
+            R(4710.9527f),
+            R(4790.7273f),
+            R(4843.2954f),
+            R(4888.4778f),
+            R(4957.1356f),
+            R(5051.3241f),
+            R(5158.7668f),
+            R(5262.7954f),
+            R(5347.7742f),
+            R(5405.3462f),
+            R(5448.8498f),
+            R(5511.8685f),
+            R(5601.6782f),
+            R(5707.7473f),
+        },
+        .pointCount = 72,
+    },
+    { // 4: 向下延伸的繞行路徑
+        .points = {
+            { R(650.0000f), R(450.0000f) },
+            { R(609.6676f), R(419.6166f) },
+            { R(501.6842f), R(391.2132f) },
+            { R(360.8914f), R(366.6410f) },
+            { R(232.7173f), R(347.5012f) },
+            { R(158.5185f), R(335.0413f) },
+            { R(162.2359f), R(330.0731f) },
+            { R(242.6699f), R(332.9205f) },
+            { R(373.8679f), R(343.3980f) },
+            { R(513.4976f), R(360.8226f) },
+            { R(616.5064f), R(384.0589f) },
+            { R(649.6574f), R(411.5926f) },
+            { R(602.2542f), R(441.6292f) },
+            { R(489.5920f), R(472.2114f) },
+            { R(348.0221f), R(501.3461f) },
+            { R(223.2233f), R(527.1345f) },
+            { R(155.4631f), R(547.8962f) },
+            { R(166.6049f), R(562.2779f) },
+            { R(253.0537f), R(569.3426f) },
+            { R(386.9160f), R(568.6298f) },
+            { R(525.0000f), R(560.1859f) },
+            { R(622.7516f), R(544.5613f) },
+            { R(648.6305f), R(522.7741f) },
+            { R(594.2865f), R(496.2443f) },
+            { R(477.2542f), R(466.7008f) },
+            { R(335.2952f), R(436.0689f) },
+            { R(214.2138f), R(406.3448f) },
+            { R(153.0779f), R(379.4658f) },
+            { R(171.6136f), R(357.1834f) },
+            { R(263.8402f), R(340.9499f) },
+            { R(400.0000f), R(331.8231f) },
+            { R(536.1598f), R(330.3978f) },
+            { R(628.3864f), R(336.7670f) },
+            { R(646.9221f), R(350.5155f) },
+            { R(585.7862f), R(370.7474f) },
+            { R(464.7048f), R(396.1441f) },
+            { R(322.7458f), R(425.0506f) },
+            { R(205.7135f), R(455.5830f) },
+            { R(151.3695f), R(485.7516f) },
+            { R(177.2484f), R(513.5903f) },
+            { R(275.0000f), R(537.2848f) },
+            { R(413.0840f), R(555.2910f) },
+            { R(546.9463f), R(566.4355f) },
+            { R(633.3951f), R(569.9919f) },
+            { R(644.5369f), R(565.7284f) },
+            { R(576.7767f), R(553.9230f) },
+            { R(451.9779f), R(535.3450f) },
+            { R(310.4080f), R(511.2051f) },
+            { R(197.7458f), R(483.0765f) },
+            { R(150.3426f), R(452.7923f) },
+            { R(183.4936f), R(422.3261f) },
+            { R(286.5024f), R(393.6634f) },
+            { R(426.1321f), R(368.6722f) },
+            { R(557.3301f), R(348.9810f) },
+            { R(637.7641f), R(335.8732f) },
+            { R(641.4815f), R(330.2030f) },
+            { R(567.2827f), R(332.3399f) },
+            { R(439.1086f), R(342.1447f) },
+            { R(298.3158f), R(358.9784f) },
+            { R(190.3324f), R(381.7439f) },
+            { R(150.0000f), R(408.9576f) },
+            { R(190.3324f), R(438.8460f) },
+            { R(298.3158f), R(469.4614f) },
+            { R(439.1086f), R(498.8084f) },
+            { R(567.2827f), R(524.9746f) },
+            { R(641.4815f), R(546.2548f) },
+            { R(637.7641f), R(561.2621f) },
+            { R(557.3301f), R(569.0184f) },
+            { R(426.1321f), R(569.0184f) },
+            { R(286.5024f), R(561.2621f) },
+            { R(183.4936f), R(546.2548f) },
+            { R(150.3426f), R(524.9746f) },
+        },
+        .tangent = {
+            { R(-0.798723f), R(-0.601699f) },
+            { R(-0.967104f), R(-0.254381f) },
+            { R(-0.985109f), R(-0.171929f) },
+            { R(-0.989034f), R(-0.147689f) },
+            { R(-0.986192f), R(-0.165608f) },
+            { R(0.599093f), R(-0.800680f) },
+            { R(0.999374f), R(0.035379f) },
+            { R(0.996826f), R(0.079606f) },
+            { R(0.992303f), R(0.123831f) },
+            { R(0.975489f), R(0.220047f) },
+            { R(0.769273f), R(0.638921f) },
+            { R(-0.844701f), R(0.535239f) },
+            { R(-0.965076f), R(0.261970f) },
+            { R(-0.979474f), R(0.201573f) },
+            { R(-0.979310f), R(0.202365f) },
+            { R(-0.956126f), R(0.292956f) },
+            { R(0.612431f), R(0.790524f) },
+            { R(0.996677f), R(0.081450f) },
+            { R(0.999986f), R(-0.005325f) },
+            { R(0.998136f), R(-0.061036f) },
+            { R(0.987465f), R(-0.157837f) },
+            { R(0.764992f), R(-0.644040f) },
+            { R(-0.898634f), R(-0.438698f) },
+            { R(-0.969583f), R(-0.244761f) },
+            { R(-0.977502f), R(-0.210925f) },
+            { R(-0.971165f), R(-0.238409f) },
+            { R(-0.915429f), R(-0.402478f) },
+            { R(0.639514f), R(-0.768779f) },
+            { R(0.984860f), R(-0.173353f) },
+            { R(0.997761f), R(-0.066880f) },
+            { R(0.999945f), R(-0.010467f) },
+            { R(0.997624f), R(0.068896f) },
+            { R(0.803177f), R(0.595741f) },
+            { R(-0.949365f), R(0.314176f) },
+            { R(-0.978703f), R(0.205282f) },
+            { R(-0.979892f), R(0.199531f) },
+            { R(-0.967613f), R(0.252440f) },
+            { R(-0.874311f), R(0.485366f) },
+            { R(0.680856f), R(0.732418f) },
+            { R(0.971857f), R(0.235573f) },
+            { R(0.991605f), R(0.129306f) },
+            { R(0.996552f), R(0.082966f) },
+            { R(0.999155f), R(0.041104f) },
+            { R(0.933959f), R(-0.357381f) },
+            { R(-0.985160f), R(-0.171638f) },
+            { R(-0.989101f), R(-0.147241f) },
+            { R(-0.985772f), R(-0.168090f) },
+            { R(-0.970217f), R(-0.242236f) },
+            { R(-0.842705f), R(-0.538375f) },
+            { R(0.736294f), R(-0.676662f) },
+            { R(0.963399f), R(-0.268071f) },
+            { R(0.984358f), R(-0.176183f) },
+            { R(0.988924f), R(-0.148425f) },
+            { R(0.986980f), R(-0.160841f) },
+            { R(0.548271f), R(-0.836301f) },
+            { R(-0.999586f), R(0.028788f) },
+            { R(-0.997087f), R(0.076273f) },
+            { R(-0.992928f), R(0.118718f) },
+            { R(-0.978491f), R(0.206289f) },
+            { R(-0.828950f), R(0.559323f) },
+            { R(0.803437f), R(0.595390f) },
+            { R(0.962080f), R(0.272768f) },
+            { R(0.978959f), R(0.204056f) },
+            { R(0.979792f), R(0.200021f) },
+            { R(0.961248f), R(0.275685f) },
+            { R(-0.240435f), R(0.970665f) },
+            { R(-0.995383f), R(0.095986f) },
+            { R(-1.000000f), R(0.000000f) },
+            { R(-0.998461f), R(-0.055464f) },
+            { R(-0.989553f), R(-0.144167f) },
+            { R(-0.841539f), R(-0.540197f) },
+            { R(0.988929f), R(-0.148391f) },
+        },
+        .arcLength = {
+            R(0.0f),
+            R(50.4961f),
+            R(162.1526f),
+            R(305.0736f),
+            R(434.6687f),
+            R(509.9065f),
+            R(516.1114f),
+            R(596.5958f),
+            R(728.2115f),
+            R(868.9242f),
+            R(974.5212f),
+            R(1017.6152f),
+            R(1073.7335f),
+            R(1190.4727f),
+            R(1335.0095f),
+            R(1462.4449f),
+            R(1533.3144f),
+            R(1551.5071f),
+            R(1638.2441f),
+            R(1772.1083f),
+            R(1910.4502f),
+            R(2009.4427f),
+            R(2043.2716f),
+            R(2103.7456f),
+            R(2224.4492f),
+            R(2369.6755f),
+            R(2494.3520f),
+            R(2561.1359f),
+            R(2590.1199f),
+            R(2683.7643f),
+            R(2820.2296f),
+            R(2956.3969f),
+            R(3048.8431f),
+            R(3071.9211f),
+            R(3136.3178f),
+            R(3260.0340f),
+            R(3404.9062f),
+            R(3525.8556f),
+            R(3588.0120f),
+            R(3626.0213f),
+            R(3726.6037f),
+            R(3865.8567f),
+            R(4000.1821f),
+            R(4086.7041f),
+            R(4098.6337f),
+            R(4167.4146f),
+            R(4293.5886f),
+            R(4437.2019f),
+            R(4553.3225f),
+            R(4609.5737f),
+            R(4654.5979f),
+            R(4761.5200f),
+            R(4903.3686f),
+            R(5036.0361f),
+            R(5117.5312f),
+            R(5124.3112f),
+            R(5198.5408f),
+            R(5327.0893f),
+            R(5468.8849f),
+            R(5579.2420f),
+            R(5627.8968f),
+            R(5678.0966f),
+            R(5790.3362f),
+            R(5934.1550f),
+            R(6064.9726f),
+            R(6142.1627f),
+            R(6157.6235f),
+            R(6238.4307f),
+            R(6369.6287f),
+            R(6509.4737f),
+            R(6613.5698f),
+            R(6652.9632f),
+            R(7158.2143f),
+        },
+        .pointCount = 72,
+    },
+};
+#endif
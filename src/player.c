@@ -1,66 +1,127 @@
 
 #include "animframe.h"
+#include "autopilot.h"
 #include "brickout.h"
+#include "event.h"
+#include "player.h"
+#include "projectile.h"
 #include "raylib.h"
+#include "real.h"
+#include "render.h"
+#include "statehash.h"
 #include "timer.h"
+#include "world.h"
 
-// Player structure
-typedef struct {
-    Rect rect; // 玩家板的矩形區域 (x, y, width, height)
-    float velocity; // 玩家板的移動速度
-    int score; // 玩家分數
-    AnimFrame af;
-} Player;
+#define LASER_POWER_TICKS TIMER_SECONDS(8.0f) // 雷射道具的持續時間
+#define LASER_FIRE_TICKS 4 // 發射間隔 (tick)，每次從玩家板兩端各發射一發
+#define LASER_INSET R(6.0f) // 發射口與玩家板兩端的距離
 
-Player player = { 0 }; // 全域玩家物件
+static AnimFrame playerAf = { 0 }; // 玩家板貼圖 (不屬於模擬狀態，快照時不保存)
 
-// 初始化玩家
+// 載入玩家板貼圖 (所有世界共用)
 void PlayerInit(float w, float h)
 {
-    player.af = AnimFrameLoad("asset/paddle.png", w, h);
-    player.rect = (Rect) { SCR_WIDTH / 2.0f - w / 2.0f, SCR_HEIGHT - h - 20.0f, w, h }; // 初始位置在底部中央
-    player.score = 0; // 初始分數為0
-    player.velocity = 500.0f; // 移動速度 (像素/秒)
+    // 先取得新的引用再釋放舊的，重複初始化時直接命中紋理快取，不會重新上傳
+    AnimFrame af = AnimFrameLoad("asset/paddle.png", w, h);
+    AnimFrameUnload(&playerAf);
+    playerAf = af;
+    AnimFrameTrack(&playerAf); // 素材熱重載時同步更新
+}
+// 初始化目前世界中的玩家
+void PlayerReset(float w, float h)
+{
+    Player* player = &gWorld->player;
+    player->rect = (RRect) { RFromFloat(SCR_WIDTH / 2.0f - w / 2.0f), RFromFloat(SCR_HEIGHT - h - 20.0f), RFromFloat(w), RFromFloat(h) }; // 初始位置在底部中央
+    player->score = 0; // 初始分數為0
+    player->velocity = R(500.0f); // 移動速度 (像素/秒)
+    player->laserTicks = 0;
+    player->laserCooldown = 0;
 }
 void PlayerFini()
 {
-    AnimFrameUnload(&player.af);
+    AnimFrameUnload(&playerAf);
 }
-// 更新玩家狀態 (處理鍵盤輸入)
+// 更新玩家狀態 (輸入由 GameUpdate、外部控制器或自動駕駛寫入 gWorld->input)
 void PlayerUpdate()
 {
-    float deltaTime = gTimer.DeltaTime(); // 獲取幀間時間差
+    Player* player = &gWorld->player;
+    Real deltaTime = RDeltaTime(); // 獲取幀間時間差
+    if (gWorld->autopilot.enabled) {
+        AutopilotUpdate(); // 自動駕駛覆寫本 tick 的輸入
+    }
 
-    if (IsKeyDown(KEY_LEFT) || IsKeyDown(KEY_A)) { // 左移
-        player.rect.x -= player.velocity * deltaTime;
-        if (player.rect.x < 0) { // 防止移出左邊界
-            player.rect.x = 0;
+    if (gWorld->input.left) { // 左移
+        player->rect.x -= RMulDt(player->velocity, deltaTime);
+        if (player->rect.x < 0) { // 防止移出左邊界
+            player->rect.x = 0;
+        }
+    }
+    if (gWorld->input.right) { // 右移
+        player->rect.x += RMulDt(player->velocity, deltaTime);
+        if ((player->rect.x + player->rect.width) > R(SCR_WIDTH)) { // 防止移出右邊界
+            player->rect.x = R(SCR_WIDTH) - player->rect.width;
         }
     }
-    if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) { // 右移
-        player.rect.x += player.velocity * deltaTime;
-        if ((player.rect.x + player.rect.width) > SCR_WIDTH) { // 防止移出右邊界
-            player.rect.x = SCR_WIDTH - player.rect.width;
+    if (player->laserTicks > 0) { // 雷射道具：按住發射鍵時從玩家板兩端連續發射
+        player->laserTicks--;
+        if (player->laserCooldown > 0) {
+            player->laserCooldown--;
+        } else if (gWorld->input.fire) {
+            Real y = player->rect.y - R(PROJECTILE_H);
+            ProjectileFire((RVec2) { player->rect.x + LASER_INSET, y });
+            ProjectileFire((RVec2) { player->rect.x + player->rect.width - LASER_INSET - R(PROJECTILE_W), y });
+            player->laserCooldown = LASER_FIRE_TICKS - 1;
         }
     }
 }
 // 繪製玩家板
-void PlayerDraw()
+void PlayerRender(RenderFrame* f)
 {
-    Vec2 pos = { player.rect.x, player.rect.y };
-    DrawTextureV(player.af.tex, pos, WHITE); // 直接使用左上角位置繪製
+    Player* player = &gWorld->player;
+    RenderPushSprite(f, &playerAf, (RVec2) { player->rect.x, player->rect.y }, 0, RENDER_TEXTURE); // 直接使用左上角位置繪製
 }
 // 增加玩家分數
 void PlayerAddScore(int score)
 {
-    player.score += score;
+    gWorld->player.score += score;
+}
+// 批次處理本幀事件：累加擊中得分 (只寫入一次)，擊中 ENEMY_CAKE 時取得雷射道具，球掉落時重置玩家
+// 同一個敵人在同一 tick 被多顆球或雷射擊中時只得分一次 (與 EnemyHandleEvents 只移除一次一致)。
+// (在 EnemyHandleEvents 之前呼叫，擊中事件中的敵人索引仍然有效)
+void PlayerHandleEvents()
+{
+    uint8_t hit[MAX_ENEMYS] = { 0 }; // 本 tick 已得分的敵人
+    int hits = 0;
+    bool lost = false;
+    for (int i = 0; i < EventCount(); i++) {
+        const GameEvent* ev = EventGet(i);
+        if (ev->type == EVENT_HIT) {
+            int index = ev->hit.index;
+            if (index < 0 || index >= gWorld->enemys.count || hit[index]) {
+                continue;
+            }
+            hit[index] = 1;
+            hits++;
+            if (gWorld->enemys.cold.eType[index] == ENEMY_CAKE) {
+                gWorld->player.laserTicks = LASER_POWER_TICKS;
+            }
+        } else if (ev->type == EVENT_BALL_LOST) {
+            lost = true;
+        }
+    }
+    if (hits > 0) {
+        PlayerAddScore(hits * HIT_SCORE); // 增加分數
+    }
+    if (lost) {
+        PlayerReset(PADDLE_W, PADDLE_H); // 可以選擇是否重置玩家分數
+    }
 }
 // 球與玩家板的碰撞檢測
 // pos: 球的中心位置, radius: 球的半徑
-bool PlayerCollision(Vec2 ballCenterPos, float ballRadius)
+bool PlayerCollision(RVec2 ballCenterPos, Real ballRadius)
 {
-    // 使用 Raylib 的圓形與矩形碰撞檢測函數
-    if (CheckCollisionCircleRec(ballCenterPos, ballRadius, player.rect)) {
+    // 圓形與矩形碰撞檢測 (定點模式下只使用整數運算)
+    if (RCheckCollisionCircleRec(ballCenterPos, ballRadius, gWorld->player.rect)) {
         return true; // 發生碰撞
     }
     return false; // 未發生碰撞
@@ -68,12 +129,30 @@ bool PlayerCollision(Vec2 ballCenterPos, float ballRadius)
 // 獲取玩家當前分數
 int PlayerScore()
 {
-    return player.score;
+    return gWorld->player.score;
 }
 // get paddle hit point
-float PlayerPaddleDiff(Vec2 pos)
+Real PlayerPaddleDiff(RVec2 pos)
 {
-    float paddleCenterX = player.rect.x + player.rect.width / 2;
-    float hitDeltaX = (pos.x - paddleCenterX) / (player.rect.width / 2); // -1 到 1
+    Player* player = &gWorld->player;
+    Real paddleCenterX = player->rect.x + player->rect.width / 2;
+    Real hitDeltaX = RDiv(pos.x - paddleCenterX, player->rect.width / 2); // -1 到 1
     return hitDeltaX;
-}
\ No newline at end of file
+}
+// 玩家的模擬狀態 (快照用)
+StateBlock PlayerStateBlock()
+{
+    return (StateBlock) { &gWorld->player, sizeof(Player) };
+}
+
+// 將玩家的狀態 (位置、速度、分數、雷射道具) 逐欄位累加進雜湊值 (不含結構尾端的填充位元組)
+uint64_t PlayerStateHash(uint64_t h)
+{
+    const Player* player = &gWorld->player;
+    h = StateHashBytes(h, &player->rect, sizeof(player->rect));
+    h = StateHashBytes(h, &player->velocity, sizeof(player->velocity));
+    h = StateHashBytes(h, &player->score, sizeof(player->score));
+    h = StateHashBytes(h, &player->laserTicks, sizeof(player->laserTicks));
+    h = StateHashBytes(h, &player->laserCooldown, sizeof(player->laserCooldown));
+    return h;
+}
@@ -1,14 +1,34 @@
 #ifndef __PADDLE_H__
 #define __PADDLE_H__
 #include "brickout.h"
+#include "real.h"
+#include "snapshot.h"
+#include <stdint.h>
+
+typedef struct RenderFrame RenderFrame; // render.h
+
+#define HIT_SCORE 10 // 每擊中一個敵人的得分
+
+// Player structure (屬於 GameWorld 的模擬狀態)
+typedef struct {
+    RRect rect; // 玩家板的矩形區域 (x, y, width, height)
+    Real velocity; // 玩家板的移動速度
+    int score; // 玩家分數
+    uint16_t laserTicks; // 雷射道具剩餘的 tick 數 (0 表示沒有；擊中 ENEMY_CAKE 時取得)
+    uint8_t laserCooldown; // 距離下一次可發射的 tick 數
+} Player;
 
 // Player functions
-void PlayerInit(float w, float h); // 玩家初始化
+void PlayerInit(float w, float h); // 載入玩家板貼圖
+void PlayerReset(float w, float h); // 重設目前世界中的玩家
 void PlayerFini();
-void PlayerUpdate(); // 玩家邏輯更新 (處理輸入)
-void PlayerDraw(); // 玩家繪製
+void PlayerUpdate(); // 玩家邏輯更新 (讀取世界的輸入狀態)
+void PlayerRender(RenderFrame* f); // 將玩家板加入繪製清單
 void PlayerAddScore(int score); // 增加玩家分數
-bool PlayerCollision(Vec2 pos, float radius); // 球與玩家板的碰撞檢測
+void PlayerHandleEvents(); // 批次處理本幀事件
+bool PlayerCollision(RVec2 pos, Real radius); // 球與玩家板的碰撞檢測
 int PlayerScore(); // 獲取玩家當前分數
-float PlayerPaddleDiff(Vec2 pos);
+Real PlayerPaddleDiff(RVec2 pos);
+StateBlock PlayerStateBlock(); // 玩家的模擬狀態 (快照用)
+uint64_t PlayerStateHash(uint64_t h); // 將玩家的狀態累加進雜湊值
 #endif
\ No newline at end of file
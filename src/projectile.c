@@ -0,0 +1,168 @@
+#include "projectile.h"
+#include "brickout.h"
+#include "event.h"
+#include "raycast.h"
+#include "raylib.h"
+#include "render.h"
+#include "spritemask.h"
+#include "statehash.h"
+#include "world.h"
+
+_Static_assert(PROJECTILE_MAX < PROJECTILE_NIL, "projectile index must fit in uint16_t");
+_Static_assert(PROJECTILE_W <= RAY_CELL_SIZE && PROJECTILE_H <= RAY_CELL_SIZE, "a projectile must span at most 2x2 cells");
+
+static SpriteMask laserMask; // 雷射的碰撞遮罩 (實心矩形，所有世界共用)
+
+/**
+ * @brief 產生雷射的碰撞遮罩 (所有世界共用，建立世界之前呼叫一次)
+ */
+void ProjectileMaskInit()
+{
+    SpriteMaskBox(&laserMask, PROJECTILE_W, PROJECTILE_H, PROJECTILE_W, PROJECTILE_H);
+}
+
+/**
+ * @brief 清空目前世界的投射物 (只重設串列，不清空陣列)
+ */
+void ProjectileReset()
+{
+    Projectiles* p = &gWorld->projectiles;
+    p->freeList = PROJECTILE_NIL;
+    p->used = 0;
+    p->live = 0;
+}
+
+/**
+ * @brief 發射一發雷射 (向上飛行)
+ *
+ * @param pos 左上角位置
+ * @return false 若池已滿
+ */
+bool ProjectileFire(RVec2 pos)
+{
+    Projectiles* p = &gWorld->projectiles;
+    uint16_t i;
+    if (p->freeList != PROJECTILE_NIL) {
+        i = p->freeList;
+        p->freeList = p->next[i];
+    } else if (p->used < PROJECTILE_MAX) {
+        i = p->used++;
+    } else {
+        return false;
+    }
+    p->x[i] = pos.x;
+    p->y[i] = pos.y;
+    p->alive[i] = 1;
+    p->live++;
+    return true;
+}
+
+static void ProjectileFree(Projectiles* p, int i)
+{
+    p->alive[i] = 0;
+    p->next[i] = p->freeList;
+    p->freeList = (uint16_t)i;
+    p->live--;
+}
+
+static int ClampCell(int c, int n)
+{
+    return c < 0 ? 0 : (c >= n ? n - 1 : c);
+}
+
+// 投射物 (左上角 x, y) 擊中的敵人：先取格子中外框重疊的敵人，再以遮罩判定，沒有時返回 -1
+static int ProjectileHitTest(const RayGrid* g, Real x, Real y)
+{
+    int px = RFloorInt(x);
+    int py = RFloorInt(y);
+    int cx0 = ClampCell(px >> RAY_CELL_BITS, RAY_GRID_W);
+    int cx1 = ClampCell((px + PROJECTILE_W - 1) >> RAY_CELL_BITS, RAY_GRID_W);
+    int cy0 = ClampCell(py >> RAY_CELL_BITS, RAY_GRID_H);
+    int cy1 = ClampCell((py + PROJECTILE_H - 1) >> RAY_CELL_BITS, RAY_GRID_H);
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            int c = cy * RAY_GRID_W + cx;
+            for (int k = g->cellStart[c]; k < g->cellStart[c + 1]; k++) {
+                int e = g->items[k];
+                RRect b = g->box[e];
+                if (x > b.x + b.width || x + R(PROJECTILE_W) < b.x || y > b.y + b.height || y + R(PROJECTILE_H) < b.y) {
+                    continue;
+                }
+                if (EnemyOverlap(e, &laserMask, px, py)) {
+                    return e;
+                }
+            }
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 移動所有投射物並測試敵人
+ * 積分不分支 (消滅的欄位乘上 0)，可向量化；碰撞只測試投射物所在格子中的敵人。
+ * 擊中的投射物立即消滅，敵人的移除、爆炸與得分由擊中事件在幀尾批次處理。
+ */
+void ProjectileUpdate()
+{
+    Projectiles* p = &gWorld->projectiles;
+    if (p->live == 0) {
+        return;
+    }
+    Real dy = RMulDt(PROJECTILE_SPEED, RDeltaTime());
+    int used = p->used;
+    for (int i = 0; i < used; i++) {
+        p->y[i] -= dy * p->alive[i];
+    }
+    RaycastBuild(); // 敵人本 tick 移動後的位置
+    const RayGrid* g = &gWorld->rays;
+    uint8_t hit[MAX_ENEMYS] = { 0 }; // 本 tick 已寫入擊中事件的敵人
+    for (int i = 0; i < used; i++) {
+        if (!p->alive[i]) {
+            continue;
+        }
+        if (p->y[i] + R(PROJECTILE_H) < 0) { // 飛出畫面頂端
+            ProjectileFree(p, i);
+            continue;
+        }
+        int e = g->count > 0 ? ProjectileHitTest(g, p->x[i], p->y[i]) : -1;
+        if (e < 0) {
+            continue;
+        }
+        if (!hit[e]) {
+            hit[e] = 1;
+            EventPush((GameEvent) { .type = EVENT_HIT, .hit = { { p->x[i], p->y[i] }, e } });
+        }
+        ProjectileFree(p, i);
+    }
+}
+
+void ProjectileRender(RenderFrame* f)
+{
+    Projectiles* p = &gWorld->projectiles;
+    for (int i = 0; i < p->used; i++) {
+        if (p->alive[i]) {
+            RenderPushRect(f, p->x[i], p->y[i], PROJECTILE_W, PROJECTILE_H, RED);
+        }
+    }
+}
+
+/**
+ * @brief 投射物的模擬狀態 (快照用)
+ */
+StateBlock ProjectileStateBlock()
+{
+    return (StateBlock) { &gWorld->projectiles, sizeof(Projectiles) };
+}
+
+/**
+ * @brief 將投射物累加進雜湊值 (只含曾經使用過的欄位)
+ */
+uint64_t ProjectileStateHash(uint64_t h)
+{
+    Projectiles* p = &gWorld->projectiles;
+    size_t n = p->used;
+    h = StateHashBytes(h, &p->live, sizeof(p->live));
+    h = StateHashBytes(h, p->alive, n);
+    h = StateHashBytes(h, p->x, sizeof(Real) * n);
+    return StateHashBytes(h, p->y, sizeof(Real) * n);
+}
@@ -0,0 +1,37 @@
+#ifndef __PROJECTILE_H__
+#define __PROJECTILE_H__
+#include "real.h"
+#include "snapshot.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct RenderFrame RenderFrame; // render.h
+
+#define PROJECTILE_MAX 8192 // 每個世界同時存在的投射物上限
+#define PROJECTILE_NIL 0xFFFF // 空串列
+#define PROJECTILE_W 2 // 雷射的寬度 (像素)
+#define PROJECTILE_H 12 // 雷射的長度 (不小於每個 tick 的位移，才不會穿過敵人)
+#define PROJECTILE_SPEED R(600.0f) // 向上飛行的速度 (像素/秒)
+
+// 投射物池 (SoA，屬於 GameWorld 的模擬狀態)
+// 空閒欄位以 next 串成單向串列，發射與消滅都是 O(1)；[0, used) 以外的欄位從未使用過 (重設時不必清空)。
+// 每個 tick 先對 [0, used) 整批積分，再只讓存活的投射物經由格子 (RaycastBuild) 測試敵人。
+typedef struct Projectiles {
+    Real x[PROJECTILE_MAX]; // 左上角位置
+    Real y[PROJECTILE_MAX];
+    uint16_t next[PROJECTILE_MAX]; // 空閒串列的下一個欄位
+    uint8_t alive[PROJECTILE_MAX]; // 1 表示飛行中 (積分時作為乘數，消滅的投射物不再移動)
+    uint16_t freeList; // 已消滅欄位串列的開頭
+    uint16_t used; // [0, used) 的欄位曾經使用過
+    uint16_t live; // 飛行中的數量
+} Projectiles;
+
+void ProjectileMaskInit(); // 產生雷射的碰撞遮罩 (建立世界之前呼叫一次)
+void ProjectileReset(); // 清空目前世界的投射物
+bool ProjectileFire(RVec2 pos); // 在 pos (左上角) 發射一發雷射，池滿時返回 false
+void ProjectileUpdate(); // 移動所有投射物，擊中的敵人寫入 EVENT_HIT (每個敵人每 tick 一次)
+void ProjectileRender(RenderFrame* f); // 將雷射加入繪製清單
+StateBlock ProjectileStateBlock(); // 投射物的模擬狀態 (快照用)
+uint64_t ProjectileStateHash(uint64_t h); // 將飛行中的投射物累加進雜湊值
+
+#endif
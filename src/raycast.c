@@ -0,0 +1,308 @@
+#include "raycast.h"
+#include "player.h"
+#include "world.h"
+#include <string.h>
+
+#define RAY_MIN_DIR R(1.0f / 4096.0f) // 方向分量的絕對值不超過此值時視為與該軸平行 (定點模式下 1/d 才不會溢位)
+
+#ifdef FIXED_POINT
+#define RAY_FAR ((RealWide)INT64_MAX / 4) // 永遠不會到達的參數
+#else
+#define RAY_FAR 1e30f
+#endif
+
+_Static_assert(MAX_ENEMYS <= UINT8_MAX, "enemy index must fit in uint8_t");
+_Static_assert(SPRITE_MASK_MAX_SIZE <= RAY_CELL_SIZE, "an enemy box must span at most 2x2 cells");
+_Static_assert(RAY_GRID_MAX_ITEMS <= UINT16_MAX, "cellStart must fit in uint16_t");
+
+// 預先計算的射線 (每次查詢一次)
+typedef struct Ray {
+    RVec2 o; // 起點
+    RVec2 d; // 方向
+    RVec2 inv; // 方向分量的倒數 (平行時不使用)
+    bool parX, parY; // 是否與 X/Y 軸平行
+} Ray;
+
+static Ray RayMake(RVec2 origin, RVec2 dir)
+{
+    Ray r = { .o = origin, .d = dir };
+    r.parX = dir.x <= RAY_MIN_DIR && dir.x >= -RAY_MIN_DIR;
+    r.parY = dir.y <= RAY_MIN_DIR && dir.y >= -RAY_MIN_DIR;
+    if (!r.parX) {
+        r.inv.x = RDiv(R(1.0f), dir.x);
+    }
+    if (!r.parY) {
+        r.inv.y = RDiv(R(1.0f), dir.y);
+    }
+    return r;
+}
+
+// 射線與矩形的 slab 測試：進入參數 t 在 [0, tLimit] 內時返回 true，並輸出進入面的法向量
+static bool RaySlab(const Ray* r, RRect b, RealWide tLimit, RealWide* tHit, RVec2* normal)
+{
+    RealWide tNear = 0, tFar = tLimit;
+    RVec2 n = { 0, 0 };
+    if (r->parX) {
+        if (r->o.x < b.x || r->o.x > b.x + b.width) {
+            return false;
+        }
+    } else {
+        RealWide t0 = RMulWide(b.x - r->o.x, r->inv.x);
+        RealWide t1 = RMulWide(b.x + b.width - r->o.x, r->inv.x);
+        Real nx = R(-1.0f);
+        if (t0 > t1) { // 往 -X 前進：先進入右側面
+            RealWide tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+            nx = R(1.0f);
+        }
+        if (t0 > tNear) {
+            tNear = t0;
+            n = (RVec2) { nx, 0 };
+        }
+        if (t1 < tFar) {
+            tFar = t1;
+        }
+    }
+    if (r->parY) {
+        if (r->o.y < b.y || r->o.y > b.y + b.height) {
+            return false;
+        }
+    } else {
+        RealWide t0 = RMulWide(b.y - r->o.y, r->inv.y);
+        RealWide t1 = RMulWide(b.y + b.height - r->o.y, r->inv.y);
+        Real ny = R(-1.0f);
+        if (t0 > t1) {
+            RealWide tmp = t0;
+            t0 = t1;
+            t1 = tmp;
+            ny = R(1.0f);
+        }
+        if (t0 > tNear) {
+            tNear = t0;
+            n = (RVec2) { 0, ny };
+        }
+        if (t1 < tFar) {
+            tFar = t1;
+        }
+    }
+    if (tNear > tFar) {
+        return false;
+    }
+    *tHit = tNear;
+    *normal = n;
+    return true;
+}
+
+// 目前的最近命中
+typedef struct RayBest {
+    RayHit hit;
+    RealWide t;
+} RayBest;
+
+// 命中參數相同時保留先找到的，同為敵人時取索引較小者 (格子與線性版本的結果才會一致)
+static void RayOffer(RayBest* best, RealWide t, RVec2 normal, RayHitType type, int index)
+{
+    bool closer = t != best->t ? t < best->t
+                               : best->hit.type == RAY_HIT_NONE || (type == best->hit.type && index < best->hit.index);
+    if (closer) {
+        best->t = t;
+        best->hit.type = type;
+        best->hit.index = index;
+        best->hit.normal = normal;
+    }
+}
+
+static void RayTestRect(const Ray* r, RRect b, RayBest* best, RayHitType type, int index)
+{
+    RealWide t;
+    RVec2 n;
+    if (RaySlab(r, b, best->t, &t, &n)) {
+        RayOffer(best, t, n, type, index);
+    }
+}
+
+// 射線離開畫面的位置 (起點在畫面外且朝外時 t 為 0)
+static void RayTestWalls(const Ray* r, RayBest* best)
+{
+    if (!r->parX) {
+        bool right = r->d.x > 0;
+        RealWide t = RMulWide((right ? R(SCR_WIDTH) : 0) - r->o.x, r->inv.x);
+        if (t < 0) {
+            t = 0;
+        }
+        if (t <= best->t) {
+            RayOffer(best, t, (RVec2) { right ? R(-1.0f) : R(1.0f), 0 }, RAY_HIT_WALL, right ? 1 : 0);
+        }
+    }
+    if (!r->parY) {
+        bool down = r->d.y > 0;
+        RealWide t = RMulWide((down ? R(SCR_HEIGHT) : 0) - r->o.y, r->inv.y);
+        if (t < 0) {
+            t = 0;
+        }
+        if (t <= best->t) {
+            RayOffer(best, t, (RVec2) { 0, down ? R(-1.0f) : R(1.0f) }, RAY_HIT_WALL, down ? 3 : 2);
+        }
+    }
+}
+
+static int ClampCell(int c, int n)
+{
+    return c < 0 ? 0 : (c >= n ? n - 1 : c);
+}
+
+// 以 DDA 沿射線逐格測試敵人，最近命中不超過目前格子的出口時停止
+static void RayTraverse(const Ray* r, const RayGrid* g, RayBest* best)
+{
+    const RRect bounds = { 0, 0, R(RAY_GRID_W * RAY_CELL_SIZE), R(RAY_GRID_H * RAY_CELL_SIZE) };
+    RealWide tEnter;
+    RVec2 n;
+    if (g->count == 0 || !RaySlab(r, bounds, best->t, &tEnter, &n)) {
+        return;
+    }
+    RVec2 p = RVec2Add(r->o, RVec2Scale(r->d, RNarrow(tEnter)));
+    int cx = ClampCell(RFloorInt(p.x) >> RAY_CELL_BITS, RAY_GRID_W);
+    int cy = ClampCell(RFloorInt(p.y) >> RAY_CELL_BITS, RAY_GRID_H);
+    int stepX = r->d.x > 0 ? 1 : -1;
+    int stepY = r->d.y > 0 ? 1 : -1;
+    RealWide tMaxX = RAY_FAR, tMaxY = RAY_FAR; // 到達下一條格線的參數
+    RealWide tDeltaX = 0, tDeltaY = 0; // 跨越一格的參數
+    if (!r->parX) {
+        tMaxX = RMulWide(RFromInt((cx + (stepX > 0)) << RAY_CELL_BITS) - r->o.x, r->inv.x);
+        tDeltaX = RMulWide(R(RAY_CELL_SIZE), stepX > 0 ? r->inv.x : -r->inv.x);
+    }
+    if (!r->parY) {
+        tMaxY = RMulWide(RFromInt((cy + (stepY > 0)) << RAY_CELL_BITS) - r->o.y, r->inv.y);
+        tDeltaY = RMulWide(R(RAY_CELL_SIZE), stepY > 0 ? r->inv.y : -r->inv.y);
+    }
+    for (;;) {
+        int c = cy * RAY_GRID_W + cx;
+        for (int k = g->cellStart[c]; k < g->cellStart[c + 1]; k++) {
+            RayTestRect(r, g->box[g->items[k]], best, RAY_HIT_ENEMY, g->items[k]);
+        }
+        if (tMaxX < tMaxY) {
+            if (best->t < tMaxX) {
+                return; // 最近命中在已走過的格子內 (剛好在格線上時再多走一格，同參數的命中才會取到索引較小者)
+            }
+            cx += stepX;
+            if (cx < 0 || cx >= RAY_GRID_W) {
+                return;
+            }
+            tMaxX += tDeltaX;
+        } else {
+            if (best->t < tMaxY) {
+                return;
+            }
+            cy += stepY;
+            if (cy < 0 || cy >= RAY_GRID_H) {
+                return;
+            }
+            tMaxY += tDeltaY;
+        }
+    }
+}
+
+static bool RayFinish(const Ray* r, const RayBest* best, RayHit* hit)
+{
+    if (best->hit.type == RAY_HIT_NONE) {
+        return false;
+    }
+    *hit = best->hit;
+    hit->t = RNarrow(best->t);
+    hit->point = RVec2Add(r->o, RVec2Scale(r->d, hit->t));
+    return true;
+}
+
+/**
+ * @brief 依目前敵人的位置建立查詢格子 (計數排序：計數、前綴和、填入)
+ * 敵人移動、產生或移除之後，查詢前須重新建立。
+ */
+void RaycastBuild()
+{
+    RayGrid* g = &gWorld->rays;
+    const Enemys* enemys = &gWorld->enemys;
+    uint8_t range[MAX_ENEMYS][4]; // 各敵人覆蓋的格子範圍 (x0, y0, x1, y1)
+    uint16_t next[RAY_GRID_CELLS];
+    memset(g->cellStart, 0, sizeof(g->cellStart));
+    g->count = enemys->count;
+    for (int i = 0; i < g->count; i++) {
+        RRect b = EnemyBounds(i);
+        g->box[i] = b;
+        if (b.width <= 0 || b.height <= 0) { // 完全透明的精靈：不放進格子
+            memcpy(range[i], (uint8_t[4]) { 1, 0, 0, 0 }, 4); // x0 > x1：空範圍
+            continue;
+        }
+        range[i][0] = (uint8_t)ClampCell(RFloorInt(b.x) >> RAY_CELL_BITS, RAY_GRID_W);
+        range[i][1] = (uint8_t)ClampCell(RFloorInt(b.y) >> RAY_CELL_BITS, RAY_GRID_H);
+        range[i][2] = (uint8_t)ClampCell(RFloorInt(b.x + b.width) >> RAY_CELL_BITS, RAY_GRID_W);
+        range[i][3] = (uint8_t)ClampCell(RFloorInt(b.y + b.height) >> RAY_CELL_BITS, RAY_GRID_H);
+        for (int y = range[i][1]; y <= range[i][3]; y++) {
+            for (int x = range[i][0]; x <= range[i][2]; x++) {
+                g->cellStart[y * RAY_GRID_W + x + 1]++;
+            }
+        }
+    }
+    for (int c = 0; c < RAY_GRID_CELLS; c++) {
+        g->cellStart[c + 1] += g->cellStart[c];
+        next[c] = g->cellStart[c];
+    }
+    for (int i = 0; i < g->count; i++) {
+        for (int y = range[i][1]; y <= range[i][3]; y++) {
+            for (int x = range[i][0]; x <= range[i][2]; x++) {
+                g->items[next[y * RAY_GRID_W + x]++] = (uint8_t)i;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 射線查詢：返回最近的命中
+ * 先測試玩家板，再以格子測試敵人 (以目前最近的命中限制走訪範圍)，最後是畫面邊緣。
+ *
+ * @param origin 起點
+ * @param dir 方向 (單位向量時 t 即為距離)
+ * @param maxDist t 的上限
+ * @param filter 查詢對象 (RayFilter 的組合)
+ * @param hit 輸出：命中結果
+ * @return true 若有命中
+ */
+bool Raycast(RVec2 origin, RVec2 dir, Real maxDist, uint32_t filter, RayHit* hit)
+{
+    Ray r = RayMake(origin, dir);
+    RayBest best = { .t = maxDist };
+    if (filter & RAY_PADDLE) {
+        RayTestRect(&r, gWorld->player.rect, &best, RAY_HIT_PADDLE, 0);
+    }
+    if (filter & RAY_ENEMIES) {
+        RayTraverse(&r, &gWorld->rays, &best);
+    }
+    if (filter & RAY_WALLS) {
+        RayTestWalls(&r, &best);
+    }
+    return RayFinish(&r, &best, hit);
+}
+
+/**
+ * @brief 與 Raycast 相同，但逐一測試所有敵人 (不使用格子)
+ */
+bool RaycastLinear(RVec2 origin, RVec2 dir, Real maxDist, uint32_t filter, RayHit* hit)
+{
+    Ray r = RayMake(origin, dir);
+    RayBest best = { .t = maxDist };
+    const RayGrid* g = &gWorld->rays;
+    if (filter & RAY_PADDLE) {
+        RayTestRect(&r, gWorld->player.rect, &best, RAY_HIT_PADDLE, 0);
+    }
+    if (filter & RAY_ENEMIES) {
+        for (int i = 0; i < g->count; i++) {
+            if (g->box[i].width > 0 && g->box[i].height > 0) {
+                RayTestRect(&r, g->box[i], &best, RAY_HIT_ENEMY, i);
+            }
+        }
+    }
+    if (filter & RAY_WALLS) {
+        RayTestWalls(&r, &best);
+    }
+    return RayFinish(&r, &best, hit);
+}
@@ -0,0 +1,58 @@
+#ifndef __RAYCAST_H__
+#define __RAYCAST_H__
+#include "brickout.h"
+#include "enemy.h"
+#include "real.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// 射線查詢 (雷射、瞄準輔助、自動駕駛的軌跡預測、敵人視線)
+// 敵人以實心外框 (AABB) 表示，依外框覆蓋的格子以計數排序放進均勻格子；
+// 查詢時以 DDA 沿射線逐格前進，只測試經過的格子中的敵人，找到的最近命中落在已走過的範圍內即停止。
+// 玩家板與畫面邊緣各只有一個矩形，直接以 slab 測試。
+
+#define RAY_CELL_BITS 6 // 格子大小為 2^RAY_CELL_BITS 像素 (不小於敵人外框，每個敵人最多佔 2x2 格)
+#define RAY_CELL_SIZE (1 << RAY_CELL_BITS)
+#define RAY_GRID_W ((SCR_WIDTH + RAY_CELL_SIZE - 1) / RAY_CELL_SIZE) // 格子覆蓋整個畫面
+#define RAY_GRID_H ((SCR_HEIGHT + RAY_CELL_SIZE - 1) / RAY_CELL_SIZE)
+#define RAY_GRID_CELLS (RAY_GRID_W * RAY_GRID_H)
+#define RAY_GRID_MAX_ITEMS (MAX_ENEMYS * 4)
+
+// 查詢的對象 (可組合)
+typedef enum RayFilter {
+    RAY_ENEMIES = 1 << 0,
+    RAY_PADDLE = 1 << 1,
+    RAY_WALLS = 1 << 2, // 畫面邊緣 (index 0: 左, 1: 右, 2: 上, 3: 下)
+    RAY_ALL = RAY_ENEMIES | RAY_PADDLE | RAY_WALLS,
+} RayFilter;
+
+typedef enum RayHitType {
+    RAY_HIT_NONE = 0,
+    RAY_HIT_ENEMY,
+    RAY_HIT_PADDLE,
+    RAY_HIT_WALL,
+} RayHitType;
+
+// 命中結果
+typedef struct RayHit {
+    RayHitType type;
+    int index; // 敵人索引或畫面邊緣編號
+    Real t; // 沿射線的參數 (方向為單位向量時即為距離)
+    RVec2 point; // 命中位置
+    RVec2 normal; // 命中面的法向量 (起點在外框內時為 0)
+} RayHit;
+
+// 敵人的查詢格子 (屬於 GameWorld 但不是模擬狀態，快照不保存)
+// 由 RaycastBuild 建立；敵人移動、產生或移除之後須重新建立，否則查詢的是建立時的位置。
+typedef struct RayGrid {
+    RRect box[MAX_ENEMYS]; // 建立時各敵人的實心外框
+    uint16_t cellStart[RAY_GRID_CELLS + 1]; // 格子 c 的敵人為 items[cellStart[c], cellStart[c + 1])
+    uint8_t items[RAY_GRID_MAX_ITEMS]; // 依格子排序的敵人索引
+    int count; // 建立時的敵人數量
+} RayGrid;
+
+void RaycastBuild(); // 依目前敵人的位置建立查詢格子
+bool Raycast(RVec2 origin, RVec2 dir, Real maxDist, uint32_t filter, RayHit* hit); // 最近的命中 (t 不超過 maxDist)
+bool RaycastLinear(RVec2 origin, RVec2 dir, Real maxDist, uint32_t filter, RayHit* hit); // 逐一測試所有敵人 (驗證與基準測試的對照)
+
+#endif
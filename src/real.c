@@ -0,0 +1,182 @@
+#include "real.h"
+#include "timer.h"
+#include <math.h>
+
+#ifdef FIXED_POINT
+
+// 四分之一週期正弦表: sin(i / 256 * PI / 2) 的 Q16.16 值 (以常數寫死，不依賴 libm 的實作)
+static const int32_t sinQuarter[257] = {
+    0, 402, 804, 1206, 1608, 2010, 2412, 2814,
+    3216, 3617, 4019, 4420, 4821, 5222, 5623, 6023,
+    6424, 6824, 7224, 7623, 8022, 8421, 8820, 9218,
+    9616, 10014, 10411, 10808, 11204, 11600, 11996, 12391,
+    12785, 13180, 13573, 13966, 14359, 14751, 15143, 15534,
+    15924, 16314, 16703, 17091, 17479, 17867, 18253, 18639,
+    19024, 19409, 19792, 20175, 20557, 20939, 21320, 21699,
+    22078, 22457, 22834, 23210, 23586, 23961, 24335, 24708,
+    25080, 25451, 25821, 26190, 26558, 26925, 27291, 27656,
+    28020, 28383, 28745, 29106, 29466, 29824, 30182, 30538,
+    30893, 31248, 31600, 31952, 32303, 32652, 33000, 33347,
+    33692, 34037, 34380, 34721, 35062, 35401, 35738, 36075,
+    36410, 36744, 37076, 37407, 37736, 38064, 38391, 38716,
+    39040, 39362, 39683, 40002, 40320, 40636, 40951, 41264,
+    41576, 41886, 42194, 42501, 42806, 43110, 43412, 43713,
+    44011, 44308, 44604, 44898, 45190, 45480, 45769, 46056,
+    46341, 46624, 46906, 47186, 47464, 47741, 48015, 48288,
+    48559, 48828, 49095, 49361, 49624, 49886, 50146, 50404,
+    50660, 50914, 51166, 51417, 51665, 51911, 52156, 52398,
+    52639, 52878, 53114, 53349, 53581, 53812, 54040, 54267,
+    54491, 54714, 54934, 55152, 55368, 55582, 55794, 56004,
+    56212, 56418, 56621, 56823, 57022, 57219, 57414, 57607,
+    57798, 57986, 58172, 58356, 58538, 58718, 58896, 59071,
+    59244, 59415, 59583, 59750, 59914, 60075, 60235, 60392,
+    60547, 60700, 60851, 60999, 61145, 61288, 61429, 61568,
+    61705, 61839, 61971, 62101, 62228, 62353, 62476, 62596,
+    62714, 62830, 62943, 63054, 63162, 63268, 63372, 63473,
+    63572, 63668, 63763, 63854, 63944, 64031, 64115, 64197,
+    64277, 64354, 64429, 64501, 64571, 64639, 64704, 64766,
+    64827, 64884, 64940, 64993, 65043, 65091, 65137, 65180,
+    65220, 65259, 65294, 65328, 65358, 65387, 65413, 65436,
+    65457, 65476, 65492, 65505, 65516, 65525, 65531, 65535,
+    65536,
+};
+
+// 整數平方根 (逐位元法)
+static uint64_t ISqrt64(uint64_t v)
+{
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > v) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+/**
+ * @brief 定點數平方根: sqrt(a / ONE) * ONE = sqrt(a * ONE)
+ */
+Real RSqrtWide(RealWide a)
+{
+    if (a <= 0) {
+        return 0;
+    }
+    return (Real)ISqrt64((uint64_t)a << FIXED_FRAC_BITS);
+}
+
+// 四分之一週期內的正弦，pos 為 [0, 16384] (14 位元相位)，線性內插，返回 Q16.16
+static int32_t SinQuarter(uint32_t pos)
+{
+    uint32_t i = pos >> 6;
+    int32_t frac = (int32_t)(pos & 63);
+    if (i >= 256) {
+        return sinQuarter[256];
+    }
+    return sinQuarter[i] + (((sinQuarter[i + 1] - sinQuarter[i]) * frac) >> 6);
+}
+
+/**
+ * @brief 查表正弦，角度以「圈」為單位 (1.0 = 360 度)
+ */
+Real RSinTurns(Real turns)
+{
+    // 取小數部分並換算為 16 位元相位
+    uint32_t phase = FIXED_FRAC_BITS >= 16 ? ((uint32_t)turns >> (FIXED_FRAC_BITS - 16)) & 0xFFFF : ((uint32_t)turns << (16 - FIXED_FRAC_BITS)) & 0xFFFF;
+    uint32_t quadrant = phase >> 14;
+    uint32_t pos = phase & 0x3FFF;
+    int32_t v;
+    switch (quadrant) {
+    case 0: v = SinQuarter(pos); break;
+    case 1: v = SinQuarter(16384 - pos); break;
+    case 2: v = -SinQuarter(pos); break;
+    default: v = -SinQuarter(16384 - pos); break;
+    }
+    // Q16.16 轉換到目前的小數位元數
+    return FIXED_FRAC_BITS >= 16 ? v * (1 << (FIXED_FRAC_BITS - 16)) : v / (1 << (16 - FIXED_FRAC_BITS));
+}
+
+/**
+ * @brief 查表餘弦: cos(t) = sin(t + 1/4 圈)
+ */
+Real RCosTurns(Real turns)
+{
+    return RSinTurns(turns + REAL_ONE / 4);
+}
+
+/**
+ * @brief 定點模式固定以 1/FIXED_TICK_HZ 秒前進
+ */
+Real RDeltaTime()
+{
+    return FIXED_TICK_DT;
+}
+
+/**
+ * @brief 取餘數並映射到 [0, b)
+ */
+Real RWrap(Real a, Real b)
+{
+    Real r = a % b;
+    return r < 0 ? r + b : r;
+}
+
+#else
+
+Real RSqrtWide(RealWide a)
+{
+    return a > 0 ? sqrtf(a) : 0.0f;
+}
+
+Real RSinTurns(Real turns)
+{
+    return sinf(turns * 2.0f * PI);
+}
+
+Real RCosTurns(Real turns)
+{
+    return cosf(turns * 2.0f * PI);
+}
+
+Real RDeltaTime()
+{
+    return gTimer.DeltaTime();
+}
+
+Real RWrap(Real a, Real b)
+{
+    Real r = fmodf(a, b);
+    return r < 0 ? r + b : r;
+}
+
+#endif
+
+/**
+ * @brief 正規化向量，長度為 0 時原樣返回
+ */
+RVec2 RVec2Normalize(RVec2 v)
+{
+    Real len = RSqrtWide(RVec2LengthSqr(v));
+    if (len == 0) {
+        return v;
+    }
+    return (RVec2) { RDiv(v.x, len), RDiv(v.y, len) };
+}
+
+/**
+ * @brief 圓形與矩形的碰撞檢測 (取矩形上最接近圓心的點比較距離)
+ */
+bool RCheckCollisionCircleRec(RVec2 center, Real radius, RRect rec)
+{
+    Real cx = center.x < rec.x ? rec.x : (center.x > rec.x + rec.width ? rec.x + rec.width : center.x);
+    Real cy = center.y < rec.y ? rec.y : (center.y > rec.y + rec.height ? rec.y + rec.height : center.y);
+    RVec2 d = { center.x - cx, center.y - cy };
+    return RVec2LengthSqr(d) <= RMulWide(radius, radius);
+}
@@ -0,0 +1,89 @@
+#ifndef __REAL_H__
+#define __REAL_H__
+#include "brickout.h"
+#include <math.h>
+#include <stdint.h>
+
+// 模擬用的純量型別
+// 預設為 float。以 -DFIXED_POINT 編譯時改為定點數 (預設 Q16.16，-DFIXED_FRAC_BITS=8 為 Q24.8)，
+// 球、玩家板、敵人與碰撞的計算只使用整數運算 (整數平方根、查表三角函數)，
+// 不受編譯器、最佳化等級或 x87/SSE 差異影響，不同建置的重播結果逐位元相同。
+// 定點模式下每個 tick 固定前進 1/FIXED_TICK_HZ 秒 (鎖步)，不使用實際幀間時間 (互動遊戲的計時器也以固定步長前進)。
+// 1/FIXED_TICK_HZ 無法以定點數精確表示，速度換算成位移一律經過 RMulDt (一個 tick 時直接除以頻率)。
+// Q24.8 的限制：單位向量只有 8 個小數位元 (方向誤差約 0.4%)，反覆正規化的結果 (例如多球互撞後的速率)
+// 會逐漸漂移；需要長時間重播或精確物理時使用 Q16.16。
+// 繪圖時才以 RToFloat 轉換成 float。
+
+#ifdef FIXED_POINT
+
+#ifndef FIXED_FRAC_BITS
+#define FIXED_FRAC_BITS 16 // 小數位元數 (16: Q16.16, 8: Q24.8)
+#endif
+#define FIXED_TICK_HZ 60 // 定點模式的固定模擬頻率
+#define FIXED_TICK_DT (REAL_ONE / FIXED_TICK_HZ) // RDeltaTime 的值 (1/60 無法精確表示，截斷後 Q16.16 偏小約 0.02%，Q24.8 為 4/256 偏小約 6%)
+
+typedef int32_t Real;
+typedef int64_t RealWide; // 平方和等可能超出 Real 範圍的中間結果 (小數位元數相同)
+
+#define REAL_ONE ((int32_t)1 << FIXED_FRAC_BITS)
+#define R(x) ((Real)((x) * (float)REAL_ONE)) // 常數轉換 (編譯期完成)
+
+static inline Real RFromFloat(float f) { return (Real)(f * (float)REAL_ONE); }
+static inline float RToFloat(Real a) { return (float)a / (float)REAL_ONE; }
+static inline Real RMul(Real a, Real b) { return (Real)(((int64_t)a * b) >> FIXED_FRAC_BITS); }
+static inline Real RDiv(Real a, Real b) { int64_t n = (int64_t)a * REAL_ONE; return (Real)((n + ((n < 0) == (b < 0) ? b / 2 : -b / 2)) / b); } // 四捨五入 (截斷會使正規化的向量系統性地偏短)
+static inline RealWide RMulWide(Real a, Real b) { return ((int64_t)a * b) >> FIXED_FRAC_BITS; }
+static inline Real RNarrow(RealWide a) { return (Real)a; }
+static inline int RFloorInt(Real a) { return (int)(a >> FIXED_FRAC_BITS); } // 向下取整 (像素座標)
+static inline Real RFromInt(int a) { return (Real)a * REAL_ONE; }
+static inline Real RMulDt(Real v, Real dt) { return dt == FIXED_TICK_DT ? v / FIXED_TICK_HZ : RMul(v, dt); } // 速度乘上經過時間 (一個 tick 時直接除以頻率，不經過截斷的 dt)
+Real RSqrtWide(RealWide a); // 整數平方根
+Real RSinTurns(Real turns); // 查表正弦，角度以「圈」為單位
+Real RCosTurns(Real turns); // 查表餘弦，角度以「圈」為單位
+Real RDeltaTime(); // 固定為 1/FIXED_TICK_HZ 秒
+Real RWrap(Real a, Real b); // 取餘數並映射到 [0, b)
+
+#else
+
+typedef float Real;
+typedef float RealWide;
+
+#define R(x) ((float)(x))
+
+static inline Real RFromFloat(float f) { return f; }
+static inline float RToFloat(Real a) { return a; }
+static inline Real RMul(Real a, Real b) { return a * b; }
+static inline Real RDiv(Real a, Real b) { return a / b; }
+static inline RealWide RMulWide(Real a, Real b) { return a * b; }
+static inline Real RNarrow(RealWide a) { return a; }
+static inline int RFloorInt(Real a) { return (int)floorf(a); }
+static inline Real RFromInt(int a) { return (Real)a; }
+static inline Real RMulDt(Real v, Real dt) { return v * dt; }
+Real RSqrtWide(RealWide a);
+Real RSinTurns(Real turns);
+Real RCosTurns(Real turns);
+Real RDeltaTime(); // gTimer.DeltaTime()
+Real RWrap(Real a, Real b);
+
+#endif
+
+typedef struct RVec2 {
+    Real x, y;
+} RVec2;
+
+typedef struct RRect {
+    Real x, y, width, height;
+} RRect;
+
+static inline RVec2 RVec2Add(RVec2 a, RVec2 b) { return (RVec2) { a.x + b.x, a.y + b.y }; }
+static inline RVec2 RVec2Sub(RVec2 a, RVec2 b) { return (RVec2) { a.x - b.x, a.y - b.y }; }
+static inline RVec2 RVec2Scale(RVec2 v, Real s) { return (RVec2) { RMul(v.x, s), RMul(v.y, s) }; }
+static inline RVec2 RVec2ScaleDt(RVec2 v, Real dt) { return (RVec2) { RMulDt(v.x, dt), RMulDt(v.y, dt) }; } // 速度向量在 dt 內的位移
+static inline RealWide RVec2LengthSqr(RVec2 v) { return RMulWide(v.x, v.x) + RMulWide(v.y, v.y); }
+static inline RealWide RVec2DistanceSqr(RVec2 a, RVec2 b) { return RVec2LengthSqr(RVec2Sub(a, b)); }
+static inline Vec2 RVec2ToVec2(RVec2 v) { return (Vec2) { RToFloat(v.x), RToFloat(v.y) }; }
+static inline Rect RRectToRect(RRect r) { return (Rect) { RToFloat(r.x), RToFloat(r.y), RToFloat(r.width), RToFloat(r.height) }; }
+RVec2 RVec2Normalize(RVec2 v); // 長度為 0 時原樣返回
+bool RCheckCollisionCircleRec(RVec2 center, Real radius, RRect rec); // 圓形與矩形的碰撞檢測
+
+#endif
@@ -0,0 +1,110 @@
+#include "render.h"
+
+#define RENDER_FRESH 4u // middle 上的旗標：寫入端發佈後讀取端尚未取走
+#define RENDER_INDEX 3u // middle 中的緩衝區索引
+
+/**
+ * @brief 清空繪製清單
+ */
+void RenderBegin(RenderFrame* f, uint32_t tick)
+{
+    f->tick = tick;
+    f->spriteCount = 0;
+    f->rectCount = 0;
+    f->hud = (RenderHud) { 0 };
+}
+
+/**
+ * @brief 加入一個精靈 (清單已滿時忽略)
+ *
+ * @param af 精靈圖 (須在整個遊戲期間有效)
+ * @param pos RENDER_CELL 為中心，RENDER_TEXTURE 為左上角
+ * @param frame 自生成以來經過的影格數，負值視為 0
+ */
+void RenderPushSprite(RenderFrame* f, const AnimFrame* af, RVec2 pos, int frame, RenderSpriteKind kind)
+{
+    if (f->spriteCount >= RENDER_MAX_SPRITES) {
+        return;
+    }
+    f->sprites[f->spriteCount++] = (RenderSprite) { af, RToFloat(pos.x), RToFloat(pos.y), frame > 0 ? frame : 0, kind };
+}
+
+/**
+ * @brief 加入一個實心矩形 (清單已滿時忽略)，左上角取整數像素
+ */
+void RenderPushRect(RenderFrame* f, Real x, Real y, int w, int h, Color color)
+{
+    if (f->rectCount >= RENDER_MAX_RECTS) {
+        return;
+    }
+    f->rects[f->rectCount++] = (RenderRect) { (float)RFloorInt(x), (float)RFloorInt(y), (float)w, (float)h, color };
+}
+
+/**
+ * @brief 繪製精靈與矩形 (依加入的順序)
+ * 只能在主執行緒上、BeginDrawing 與 EndDrawing 之間呼叫。
+ */
+void RenderDraw(const RenderFrame* f)
+{
+    for (int i = 0; i < f->spriteCount; i++) {
+        const RenderSprite* s = &f->sprites[i];
+        const AnimFrame* af = s->af;
+        if (s->kind == RENDER_TEXTURE) {
+            DrawTextureV(af->tex, (Vec2) { s->x, s->y }, WHITE);
+            continue;
+        }
+        int col = af->xCellCount > 0 ? s->frame % af->xCellCount : 0; // 僅有水平方向的動畫，第 0 列
+        Rect sourceRec = { (float)(col * af->cellW), 0.0f, (float)af->cellW, (float)af->cellH };
+        Rect destRec = { s->x, s->y, (float)af->cellW, (float)af->cellH };
+        Vec2 origin = { (float)af->centerW, (float)af->centerH }; // 以單元格中心對齊位置
+        DrawTexturePro(af->tex, sourceRec, destRec, origin, 0.0f, WHITE);
+    }
+    for (int i = 0; i < f->rectCount; i++) {
+        const RenderRect* r = &f->rects[i];
+        DrawRectangle((int)r->x, (int)r->y, (int)r->w, (int)r->h, r->color);
+    }
+}
+
+/**
+ * @brief 初始化三緩衝 (啟動模擬執行緒之前呼叫)
+ * 寫入端從 0 開始，1 放在交換位置，讀取端持有 2；三個都是空畫面，第一次發佈之前讀取端畫出空畫面。
+ */
+void RenderQueueInit(RenderQueue* q)
+{
+    for (int i = 0; i < 3; i++) {
+        RenderBegin(&q->frames[i], 0);
+    }
+    q->back = 0;
+    q->front = 2;
+    atomic_store(&q->middle, 1u);
+}
+
+/**
+ * @brief 寫入端：目前可寫的緩衝區
+ */
+RenderFrame* RenderQueueBack(RenderQueue* q)
+{
+    return &q->frames[q->back];
+}
+
+/**
+ * @brief 寫入端：發佈寫好的緩衝區
+ * 與 middle 交換 (release 使畫面內容對讀取端可見)，換回的緩衝區若尚未被讀取就直接覆寫。
+ */
+void RenderQueuePublish(RenderQueue* q)
+{
+    q->back = atomic_exchange_explicit(&q->middle, q->back | RENDER_FRESH, memory_order_acq_rel) & RENDER_INDEX;
+}
+
+/**
+ * @brief 讀取端：最新發佈的畫面
+ * 有新畫面時以手上的緩衝區交換 (acquire 取得畫面內容)，否則繼續使用上一次的。
+ * 返回的畫面在下一次呼叫之前不會被寫入端修改。
+ */
+const RenderFrame* RenderQueueAcquire(RenderQueue* q)
+{
+    if (atomic_load_explicit(&q->middle, memory_order_relaxed) & RENDER_FRESH) {
+        q->front = atomic_exchange_explicit(&q->middle, q->front, memory_order_acq_rel) & RENDER_INDEX;
+    }
+    return &q->frames[q->front];
+}
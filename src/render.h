@@ -0,0 +1,81 @@
+#ifndef __RENDER_H__
+#define __RENDER_H__
+#include "animframe.h"
+#include "arena.h"
+#include "brickout.h"
+#include "enemy.h"
+#include "explod.h"
+#include "multiball.h"
+#include "projectile.h"
+#include "rewind.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// 繪製清單與三緩衝
+// 各模組在模擬執行緒上把要畫的東西寫進 RenderFrame (只讀取世界狀態，不呼叫 raylib)，
+// 主執行緒 (擁有視窗與 GL 環境) 再由 RenderFrame 繪製。RenderFrame 不含指向世界的指標，發佈後不再改變，
+// 模擬執行緒可以同時推進下一個 tick。精靈圖只記錄 AnimFrame 的位址，紋理與單元格尺寸在繪製時才讀取
+// (素材熱重載在主執行緒換入紋理，不會與模擬執行緒競爭)。
+
+#define RENDER_MAX_SPRITES (MAX_ENEMYS + MULTIBALL_MAX + MAX_EXPLODS + 1) // 敵人、所有球、爆炸與玩家板
+#define RENDER_MAX_RECTS PROJECTILE_MAX // 雷射
+
+// 精靈的繪製方式
+typedef enum RenderSpriteKind {
+    RENDER_CELL = 0, // 以 (x, y) 為中心繪製第 frame 個單元格 (frame 在繪製時對單元格數取模)
+    RENDER_TEXTURE, // 以 (x, y) 為左上角繪製整張紋理
+} RenderSpriteKind;
+
+typedef struct RenderSprite {
+    const AnimFrame* af; // 精靈圖 (模組的靜態資料，繪製時才讀取)
+    float x, y;
+    int frame; // 自生成以來經過的影格數 (未取模)
+    RenderSpriteKind kind;
+} RenderSprite;
+
+typedef struct RenderRect {
+    float x, y, w, h;
+    Color color;
+} RenderRect;
+
+// 抬頭顯示的數值 (在模擬執行緒上取得)
+typedef struct RenderHud {
+    int score;
+    bool autopilot;
+#ifdef DEBUG
+    FrameArenaStats arena; // 模擬執行緒的暫存配置器
+    RewindStats rewind;
+#endif
+} RenderHud;
+
+// 一幀的繪製內容
+typedef struct RenderFrame {
+    uint32_t tick; // 產生此畫面的 tick
+    int spriteCount;
+    int rectCount;
+    RenderHud hud;
+    RenderSprite sprites[RENDER_MAX_SPRITES];
+    RenderRect rects[RENDER_MAX_RECTS];
+} RenderFrame;
+
+// 單一寫入端 (模擬執行緒)、單一讀取端 (主執行緒) 的三緩衝
+// 兩端各自持有一個緩衝區，第三個放在 middle 交換；寫入端發佈與讀取端取用都只是一次原子交換，兩端都不會等待。
+// 讀取端跟不上時較舊的畫面直接被覆寫，永遠取得最新發佈的畫面。
+typedef struct RenderQueue {
+    RenderFrame frames[3];
+    atomic_uint middle; // 交換中的緩衝區索引 (RENDER_FRESH 表示發佈後讀取端尚未取走)
+    unsigned back; // 寫入端正在寫的緩衝區 (只由寫入端使用)
+    unsigned front; // 讀取端正在畫的緩衝區 (只由讀取端使用)
+} RenderQueue;
+
+void RenderBegin(RenderFrame* f, uint32_t tick); // 清空繪製清單
+void RenderPushSprite(RenderFrame* f, const AnimFrame* af, RVec2 pos, int frame, RenderSpriteKind kind); // 加入一個精靈 (清單已滿時忽略)
+void RenderPushRect(RenderFrame* f, Real x, Real y, int w, int h, Color color); // 加入一個實心矩形 (清單已滿時忽略)
+void RenderDraw(const RenderFrame* f); // 繪製精靈與矩形 (主執行緒，BeginDrawing 之後)
+void RenderQueueInit(RenderQueue* q); // 三個緩衝區都設為空畫面
+RenderFrame* RenderQueueBack(RenderQueue* q); // 寫入端：目前可寫的緩衝區
+void RenderQueuePublish(RenderQueue* q); // 寫入端：發佈寫好的緩衝區，換到下一個可寫的緩衝區
+const RenderFrame* RenderQueueAcquire(RenderQueue* q); // 讀取端：最新發佈的畫面 (沒有新畫面時返回上一次的)
+
+#endif
@@ -0,0 +1,267 @@
+#include "rewind.h"
+#include "raylib.h"
+#include "snapshot.h"
+#include "timer.h"
+#include <stdio.h>
+#include <string.h>
+
+#define REWIND_POOL_SIZE (8 * 1024 * 1024) // 壓縮資料池大小 (位元組)
+#define REWIND_MAX_ENTRIES 4096 // 最多記錄的 tick 數 (120Hz 下約 34 秒)
+#define REWIND_MAX_SNAPSHOT (256 * 1024) // 單一快照的最大位元組數
+#define REWIND_MAX_ENCODED (REWIND_MAX_SNAPSHOT + REWIND_MAX_SNAPSHOT / 64 + 16) // 最壞情況的編碼長度
+
+// 一個 tick 的記錄
+typedef struct {
+    uint32_t tick;
+    uint32_t offset; // 在資料池中的位置
+    uint32_t size; // 編碼後的位元組數
+    bool keyframe;
+} RewindEntry;
+
+typedef struct {
+    uint8_t pool[REWIND_POOL_SIZE];
+    RewindEntry entry[REWIND_MAX_ENTRIES];
+    uint32_t first; // 最舊記錄在 entry 環形陣列中的位置
+    uint32_t count; // 記錄數量
+    uint32_t writePos; // 下一筆資料寫入資料池的位置
+    uint32_t nextTick; // 下一筆記錄預期的 tick 編號 (gTimer.Tick)
+    int keyframeInterval;
+    size_t snapSize; // 快照大小 (整個遊戲期間固定)
+    size_t storedBytes; // 目前記錄佔用的資料池位元組數
+    uint8_t prev[REWIND_MAX_SNAPSHOT]; // 前一個 tick 的快照 (差異編碼的基準)
+    uint8_t cur[REWIND_MAX_SNAPSHOT]; // 目前 tick 的快照 / 跳轉時的解碼緩衝
+    uint8_t enc[REWIND_MAX_ENCODED]; // 編碼暫存
+    double seekUs;
+} RewindBuffer;
+
+static RewindBuffer rewindBuf = { 0 };
+
+// 寫入 LEB128 變長整數
+static uint8_t* PutVarint(uint8_t* p, uint32_t v)
+{
+    while (v >= 0x80) {
+        *p++ = (uint8_t)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (uint8_t)v;
+    return p;
+}
+
+// 讀取 LEB128 變長整數
+static const uint8_t* GetVarint(const uint8_t* p, uint32_t* v)
+{
+    uint32_t x = 0;
+    int shift = 0;
+    while (*p & 0x80) {
+        x |= (uint32_t)(*p++ & 0x7f) << shift;
+        shift += 7;
+    }
+    *v = x | (uint32_t)*p++ << shift;
+    return p;
+}
+
+/**
+ * @brief 將 cur XOR base 的結果以 (零行程長度, 字面長度, 字面資料) 的序列編碼
+ * base 為 NULL 時直接編碼 cur (關鍵影格)。
+ */
+static size_t Encode(const uint8_t* cur, const uint8_t* base, size_t n, uint8_t* out)
+{
+    uint8_t* p = out;
+    size_t i = 0;
+    while (i < n) {
+        size_t zeroStart = i;
+        while (i < n && (cur[i] ^ (base ? base[i] : 0)) == 0) {
+            i++;
+        }
+        size_t litStart = i;
+        // 字面資料延續到出現連續 4 個零為止，避免短零行程的編碼成本大於節省
+        size_t zeros = 0;
+        while (i < n && zeros < 4) {
+            zeros = (cur[i] ^ (base ? base[i] : 0)) == 0 ? zeros + 1 : 0;
+            i++;
+        }
+        if (zeros == 4) {
+            i -= 4;
+        }
+        p = PutVarint(p, (uint32_t)(litStart - zeroStart));
+        p = PutVarint(p, (uint32_t)(i - litStart));
+        for (size_t k = litStart; k < i; k++) {
+            *p++ = cur[k] ^ (base ? base[k] : 0);
+        }
+    }
+    return (size_t)(p - out);
+}
+
+/**
+ * @brief 將編碼資料 XOR 進 buf (buf 為前一個狀態；關鍵影格時 buf 應先清零)
+ */
+static void Decode(const uint8_t* in, size_t size, uint8_t* buf)
+{
+    const uint8_t* end = in + size;
+    size_t i = 0;
+    while (in < end) {
+        uint32_t zeroRun, litLen;
+        in = GetVarint(in, &zeroRun);
+        in = GetVarint(in, &litLen);
+        i += zeroRun;
+        for (uint32_t k = 0; k < litLen; k++) {
+            buf[i++] ^= *in++;
+        }
+    }
+}
+
+static RewindEntry* EntryAt(uint32_t i)
+{
+    return &rewindBuf.entry[(rewindBuf.first + i) % REWIND_MAX_ENTRIES];
+}
+
+// 移除最舊的記錄
+static void EvictOldest()
+{
+    rewindBuf.storedBytes -= EntryAt(0)->size;
+    rewindBuf.first = (rewindBuf.first + 1) % REWIND_MAX_ENTRIES;
+    rewindBuf.count--;
+}
+
+// 判斷最舊的記錄是否與資料池區間 [pos, pos + size) 重疊
+static bool OldestOverlaps(uint32_t pos, uint32_t size)
+{
+    RewindEntry* e = EntryAt(0);
+    return e->offset < pos + size && pos < e->offset + e->size;
+}
+
+/**
+ * @brief 清空緩衝區
+ */
+bool RewindInit(int keyframeInterval)
+{
+    rewindBuf.first = 0;
+    rewindBuf.count = 0;
+    rewindBuf.writePos = 0;
+    rewindBuf.nextTick = 0;
+    rewindBuf.storedBytes = 0;
+    rewindBuf.seekUs = 0;
+    rewindBuf.keyframeInterval = keyframeInterval > 0 ? keyframeInterval : 1;
+    rewindBuf.snapSize = SnapshotSize();
+    if (rewindBuf.snapSize > REWIND_MAX_SNAPSHOT) {
+        printf("Error: Snapshot (%zu bytes) is too large for the rewind buffer.\n", rewindBuf.snapSize);
+        rewindBuf.snapSize = 0;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 記錄目前狀態
+ */
+void RewindRecord()
+{
+    if (rewindBuf.snapSize == 0) {
+        return;
+    }
+    if (rewindBuf.count > 0 && gTimer.Tick() != rewindBuf.nextTick) {
+        // tick 不連續 (例如從檔案讀取了快照)，舊記錄無法再接續，重新開始
+        RewindInit(rewindBuf.keyframeInterval);
+    }
+    rewindBuf.nextTick = gTimer.Tick();
+    SnapshotSave(rewindBuf.cur, rewindBuf.snapSize);
+    bool keyframe = rewindBuf.count == 0 || rewindBuf.nextTick % (uint32_t)rewindBuf.keyframeInterval == 0;
+    size_t size = Encode(rewindBuf.cur, keyframe ? NULL : rewindBuf.prev, rewindBuf.snapSize, rewindBuf.enc);
+    memcpy(rewindBuf.prev, rewindBuf.cur, rewindBuf.snapSize);
+
+    // 尾端放不下時繞回資料池開頭，並移除被覆蓋的最舊記錄
+    uint32_t pos = rewindBuf.writePos;
+    if (pos + size > REWIND_POOL_SIZE) {
+        // 位於尾端的記錄是上一圈寫入的，也就是最舊的記錄
+        while (rewindBuf.count > 0 && EntryAt(0)->offset >= pos) {
+            EvictOldest();
+        }
+        pos = 0;
+    }
+    if (rewindBuf.count == REWIND_MAX_ENTRIES) {
+        EvictOldest();
+    }
+    while (rewindBuf.count > 0 && OldestOverlaps(pos, (uint32_t)size)) {
+        EvictOldest();
+    }
+    // 差異記錄需要前面的關鍵影格才能解碼，因此最舊的記錄必須是關鍵影格
+    while (rewindBuf.count > 0 && !EntryAt(0)->keyframe) {
+        EvictOldest();
+    }
+    if (rewindBuf.count == 0 && !keyframe) {
+        // 所有記錄都被移除了，改存關鍵影格
+        keyframe = true;
+        size = Encode(rewindBuf.cur, NULL, rewindBuf.snapSize, rewindBuf.enc);
+    }
+    memcpy(rewindBuf.pool + pos, rewindBuf.enc, size);
+    *EntryAt(rewindBuf.count) = (RewindEntry) { rewindBuf.nextTick, pos, (uint32_t)size, keyframe };
+    rewindBuf.count++;
+    rewindBuf.storedBytes += size;
+    rewindBuf.writePos = pos + (uint32_t)size;
+    rewindBuf.nextTick++;
+}
+
+/**
+ * @brief 還原到指定 tick，並捨棄其後的記錄
+ * 從不晚於目標的最近關鍵影格開始解碼，最多套用 keyframeInterval - 1 筆差異。
+ */
+bool RewindSeek(uint32_t tick)
+{
+    if (rewindBuf.count == 0 || tick < EntryAt(0)->tick || tick > EntryAt(rewindBuf.count - 1)->tick) {
+        return false;
+    }
+    double t0 = GetTime();
+    uint32_t target = tick - EntryAt(0)->tick; // tick 連續遞增，可直接換算成記錄索引
+    uint32_t key = target;
+    while (!EntryAt(key)->keyframe) {
+        key--;
+    }
+    memset(rewindBuf.cur, 0, rewindBuf.snapSize);
+    for (uint32_t i = key; i <= target; i++) {
+        RewindEntry* e = EntryAt(i);
+        Decode(rewindBuf.pool + e->offset, e->size, rewindBuf.cur);
+    }
+    if (!SnapshotRestore(rewindBuf.cur, rewindBuf.snapSize)) {
+        return false;
+    }
+    // 捨棄目標之後的記錄，之後的記錄以還原的狀態為差異基準
+    while (rewindBuf.count > target + 1) {
+        rewindBuf.count--;
+        rewindBuf.storedBytes -= EntryAt(rewindBuf.count)->size;
+    }
+    RewindEntry* last = EntryAt(rewindBuf.count - 1);
+    rewindBuf.writePos = last->offset + last->size;
+    rewindBuf.nextTick = tick + 1; // SnapshotRestore 已將 gTimer 的 tick 設為目標
+    memcpy(rewindBuf.prev, rewindBuf.cur, rewindBuf.snapSize);
+    rewindBuf.seekUs = (GetTime() - t0) * 1e6;
+    return true;
+}
+
+/**
+ * @brief 倒退一個 tick
+ */
+bool RewindStepBack()
+{
+    if (rewindBuf.count < 2) {
+        return false;
+    }
+    return RewindSeek(EntryAt(rewindBuf.count - 2)->tick);
+}
+
+/**
+ * @brief 取得壓縮比與跳轉耗時等統計資料
+ */
+RewindStats RewindGetStats()
+{
+    RewindStats s = { 0 };
+    if (rewindBuf.count > 0) {
+        s.oldestTick = EntryAt(0)->tick;
+        s.newestTick = EntryAt(rewindBuf.count - 1)->tick;
+    }
+    s.entries = rewindBuf.count;
+    s.rawBytes = rewindBuf.snapSize * rewindBuf.count;
+    s.storedBytes = rewindBuf.storedBytes;
+    s.ratio = s.storedBytes > 0 ? (float)s.rawBytes / (float)s.storedBytes : 0.0f;
+    s.seekUs = rewindBuf.seekUs;
+    return s;
+}
@@ -0,0 +1,27 @@
+#ifndef __REWIND_H__
+#define __REWIND_H__
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 倒帶緩衝區
+// 每個 tick 記錄一份快照：每 K 個 tick 一個關鍵影格，其餘為與前一個快照的 XOR 差異，
+// 兩者都以零長度行程編碼 (RLE) 壓縮後存入固定大小的環形位元組池，最舊的資料會被覆蓋。
+
+typedef struct RewindStats {
+    uint32_t oldestTick; // 可倒帶到的最舊 tick
+    uint32_t newestTick; // 最新記錄的 tick
+    uint32_t entries; // 記錄中的 tick 數量
+    size_t rawBytes; // 未壓縮時所需的位元組數
+    size_t storedBytes; // 實際佔用的位元組數
+    float ratio; // 壓縮比 (rawBytes / storedBytes)
+    double seekUs; // 最近一次跳轉耗時 (微秒)
+} RewindStats;
+
+bool RewindInit(int keyframeInterval); // 清空緩衝區，keyframeInterval 為關鍵影格間隔 (tick)
+void RewindRecord(); // 記錄目前狀態 (每個 tick 結尾呼叫)
+bool RewindSeek(uint32_t tick); // 還原到指定 tick，並捨棄其後的記錄
+bool RewindStepBack(); // 倒退一個 tick
+RewindStats RewindGetStats();
+
+#endif
@@ -0,0 +1,219 @@
+#include "script.h"
+#include "brickout.h"
+
+#define SCRIPT_MAX_CHAIN 8 // 一個 tick 內不讓出可連續進入的指令數 (防止只有跳躍的迴圈)
+#define SCRIPT_DIVE_SPEED R(2.0f) // 俯衝速度倍率
+#define SCRIPT_RETURN_SPEED R(1.5f) // 返回速度倍率
+#define SCRIPT_DIVE_CLEARANCE R(120.0f) // 俯衝停在玩家板上方的距離 (追蹤也不低於此高度)
+
+// 所有腳本的位元組碼 (pc 為此陣列的索引)
+static const uint8_t code[] = {
+    // SCRIPT_PATROL (0)
+    OP_FOLLOW, 0,
+    // SCRIPT_DIVER (2)
+    OP_FOLLOW, 36,
+    OP_WAIT, 20,
+    OP_DIVE, 0,
+    OP_RETURN, 0,
+    OP_LOOP, 4,
+    // SCRIPT_PAUSER (12)
+    OP_FOLLOW, 12,
+    OP_WAIT, 45,
+    OP_LOOP, 2,
+    // SCRIPT_HOMER (18)
+    OP_FOLLOW, 24,
+    OP_HOME, 120,
+    OP_RETURN, 0,
+    OP_LOOP, 3,
+};
+
+static const uint8_t entry[SCRIPT_NUMS] = { 0, 2, 12, 18 };
+
+static const uint8_t typeScript[ENEMY_NUMS] = {
+    [ENEMY_FLY] = SCRIPT_PATROL,
+    [ENEMY_BUG] = SCRIPT_DIVER,
+    [ENEMY_SHIT] = SCRIPT_PAUSER,
+    [ENEMY_CAKE] = SCRIPT_HOMER, // 帶著雷射道具的敵人主動靠近球
+};
+
+_Static_assert(sizeof(code) <= UINT8_MAX, "script pc must fit in uint8_t");
+
+ScriptId ScriptForType(EnemyType type)
+{
+    return (ScriptId)typeScript[type];
+}
+
+bool ScriptHoming(ScriptId id)
+{
+    return id == SCRIPT_HOMER;
+}
+
+static inline RVec2 Aim(RVec2 from, RVec2 to, Real speed)
+{
+    return RVec2Scale(RVec2Normalize(RVec2Sub(to, from)), speed);
+}
+
+// 朝 target 移動一步 (step 為本 tick 的位移)，不越過目標
+// 這一步的長度不小於剩餘距離、或目標已在移動方向的後方 (被推過頭或 dt 過大) 時停在目標上；返回是否到達
+static inline bool MoveToward(RVec2* pos, RVec2 step, RVec2 target, RealWide reachThreshSqr)
+{
+    RVec2 to = RVec2Sub(target, *pos);
+    RealWide along = RMulWide(step.x, to.x) + RMulWide(step.y, to.y);
+    if (along <= 0 || RVec2LengthSqr(step) >= RVec2LengthSqr(to)) {
+        *pos = target;
+        return true;
+    }
+    *pos = RVec2Add(*pos, step);
+    return RVec2DistanceSqr(*pos, target) < reachThreshSqr;
+}
+
+// 追蹤的目標：最近的球，但不低於俯衝停止的高度 (不撞上玩家板)
+static inline RVec2 HomeTarget(ScriptView v, int i, RVec2 diveAt)
+{
+    RVec2 t = v.homeAt != NULL ? v.homeAt[i] : diveAt;
+    Real maxY = diveAt.y - SCRIPT_DIVE_CLEARANCE;
+    t.y = t.y > maxY ? maxY : t.y;
+    return t;
+}
+
+// 進入 pc 所指的指令 (設定速度與計數器)；立即完成的指令 (跳躍、等待 0 tick) 連續執行
+static uint32_t Enter(ScriptView v, int i, RVec2 diveAt)
+{
+    for (uint32_t steps = 1; steps <= SCRIPT_MAX_CHAIN; steps++) {
+        uint8_t pc = v.pc[i];
+        uint8_t arg = code[pc + 1];
+        switch (code[pc]) {
+        case OP_FOLLOW:
+            v.counter[i] = arg;
+            v.vel[i] = Aim(v.pos[i], EnemyPathPoint(v.target[i]), v.speed[i]);
+            return steps;
+        case OP_WAIT:
+            if (arg == 0) {
+                v.pc[i] = pc + 2;
+                continue;
+            }
+            v.counter[i] = arg;
+            v.vel[i] = (RVec2) { 0, 0 };
+            return steps;
+        case OP_DIVE:
+            v.vel[i] = Aim(v.pos[i], diveAt, RMul(v.speed[i], SCRIPT_DIVE_SPEED));
+            return steps;
+        case OP_RETURN:
+            v.vel[i] = Aim(v.pos[i], EnemyPathPoint(v.target[i]), RMul(v.speed[i], SCRIPT_RETURN_SPEED));
+            return steps;
+        case OP_HOME:
+            v.counter[i] = arg;
+            v.vel[i] = Aim(v.pos[i], HomeTarget(v, i, diveAt), v.speed[i]);
+            return steps;
+        case OP_LOOP:
+            v.pc[i] = (uint8_t)(pc - 2 * arg);
+            continue;
+        default: // OP_END
+            v.vel[i] = (RVec2) { 0, 0 };
+            return steps;
+        }
+    }
+    v.vel[i] = (RVec2) { 0, 0 }; // 腳本錯誤 (沒有讓出的迴圈)：停在原地，下一個 tick 再試
+    return SCRIPT_MAX_CHAIN;
+}
+
+/**
+ * @brief 從頭執行腳本
+ *
+ * @param v 敵人陣列
+ * @param i 敵人索引
+ * @param id 腳本
+ * @param diveAt 俯衝目標 (玩家板中心)
+ * @return 執行的指令數
+ */
+uint32_t ScriptStart(ScriptView v, int i, ScriptId id, RVec2 diveAt)
+{
+    v.pc[i] = entry[id];
+    return Enter(v, i, diveAt);
+}
+
+/**
+ * @brief 移動所有敵人並恢復其腳本一個 tick
+ * 每個敵人只執行目前指令的完成判定，大部分 tick 只是一次距離比較或計數器遞減。
+ * 前往路徑點的指令 (OP_FOLLOW、OP_RETURN) 以 MoveToward 移動，速度再快也不會越過路徑點而一去不回。
+ *
+ * @param v 敵人陣列
+ * @param dt 經過時間
+ * @param diveAt 俯衝目標 (玩家板中心)
+ * @return 執行的指令數 (每個敵人至少 1)
+ */
+uint32_t ScriptRun(ScriptView v, Real dt, RVec2 diveAt)
+{
+    const RealWide reachThreshSqr = RMulWide(REACH_THRESH, REACH_THRESH); // 到達判定的閾值 (平方值比較)
+    const Real diveStopY = diveAt.y - SCRIPT_DIVE_CLEARANCE;
+    uint32_t steps = 0;
+    for (int i = 0; i < v.count; i++) {
+        RVec2 step = RVec2ScaleDt(v.vel[i], dt);
+        uint8_t pc = v.pc[i];
+        uint8_t op = code[pc];
+        if (op != OP_FOLLOW && op != OP_RETURN) {
+            v.pos[i] = RVec2Add(v.pos[i], step);
+        }
+        bool done = false;
+        switch (op) {
+        case OP_FOLLOW:
+            if (MoveToward(&v.pos[i], step, EnemyPathPoint(v.target[i]), reachThreshSqr)) {
+                v.target[i] = EnemyPathNext(v.target[i]);
+                done = code[pc + 1] != 0 && --v.counter[i] == 0;
+                if (!done) {
+                    v.vel[i] = Aim(v.pos[i], EnemyPathPoint(v.target[i]), v.speed[i]);
+                }
+            }
+            break;
+        case OP_WAIT:
+            done = --v.counter[i] == 0;
+            break;
+        case OP_DIVE:
+            done = v.pos[i].y >= diveStopY;
+            break;
+        case OP_RETURN:
+            done = MoveToward(&v.pos[i], step, EnemyPathPoint(v.target[i]), reachThreshSqr);
+            break;
+        case OP_HOME:
+            v.vel[i] = Aim(v.pos[i], HomeTarget(v, i, diveAt), v.speed[i]);
+            done = --v.counter[i] == 0;
+            break;
+        case OP_LOOP: // 只有上一次進入時超過連續上限才會停在這裡
+            steps += Enter(v, i, diveAt);
+            continue;
+        default:
+            break;
+        }
+        steps++;
+        if (done) {
+            v.pc[i] = pc + 2;
+            steps += Enter(v, i, diveAt);
+        }
+    }
+    return steps;
+}
+
+/**
+ * @brief 位置被外力改變後 (例如敵人之間的分離) 重新瞄準目前指令的目標
+ * 速度只在進入指令與切換路徑點時設定，被推離原本的直線後不重新瞄準會錯過路徑點。
+ * 只有移動中的指令需要，停留中的敵人保持靜止。
+ */
+void ScriptAim(ScriptView v, int i, RVec2 diveAt)
+{
+    switch (code[v.pc[i]]) {
+    case OP_FOLLOW:
+        v.vel[i] = Aim(v.pos[i], EnemyPathPoint(v.target[i]), v.speed[i]);
+        break;
+    case OP_DIVE:
+        v.vel[i] = Aim(v.pos[i], diveAt, RMul(v.speed[i], SCRIPT_DIVE_SPEED));
+        break;
+    case OP_RETURN:
+        v.vel[i] = Aim(v.pos[i], EnemyPathPoint(v.target[i]), RMul(v.speed[i], SCRIPT_RETURN_SPEED));
+        break;
+    case OP_HOME:
+        v.vel[i] = Aim(v.pos[i], HomeTarget(v, i, diveAt), v.speed[i]);
+        break;
+    default:
+        break;
+    }
+}
@@ -0,0 +1,51 @@
+#ifndef __SCRIPT_H__
+#define __SCRIPT_H__
+#include "enemy.h"
+#include "real.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// 敵人行為腳本
+// 無堆疊協程：每個腳本是一段 (操作碼, 參數) 的 2 位元組指令，所有腳本串接在同一個唯讀陣列中。
+// 每個敵人只保存程式計數器 (1 位元組) 與目前指令的計數器 (2 位元組)，沒有堆疊也不配置記憶體；
+// 每個 tick 從 pc 恢復執行目前的指令，指令完成時前進到下一個指令，否則讓出到下一個 tick。
+
+// 指令
+typedef enum ScriptOp {
+    OP_END = 0, // 停在原地
+    OP_FOLLOW, // 沿路徑前進 arg 個路徑點 (0 表示永遠)
+    OP_WAIT, // 停留 arg 個 tick
+    OP_DIVE, // 朝玩家板俯衝，到達玩家板上方 SCRIPT_DIVE_CLEARANCE 時完成
+    OP_RETURN, // 飛回路徑上的目標點
+    OP_LOOP, // 往回跳 arg 個指令
+    OP_HOME, // 追蹤最近的球 arg 個 tick (每個 tick 重新瞄準，不低於俯衝的高度)
+} ScriptOp;
+
+// 內建腳本
+typedef enum ScriptId {
+    SCRIPT_PATROL = 0, // 沿路徑循環
+    SCRIPT_DIVER, // 巡航一段後停頓、俯衝、返回
+    SCRIPT_PAUSER, // 走走停停
+    SCRIPT_HOMER, // 巡航一段後追蹤最近的球、返回
+    SCRIPT_NUMS,
+} ScriptId;
+
+// 腳本操作的敵人陣列 (SoA，由 EnemyUpdate 指向世界的敵人，或由基準測試自行配置)
+typedef struct ScriptView {
+    RVec2* pos;
+    RVec2* vel;
+    uint16_t* target; // 路徑點的攤平索引
+    uint8_t* pc;
+    uint16_t* counter;
+    const Real* speed;
+    const RVec2* homeAt; // 各敵人追蹤的目標 (OP_HOME，NULL 時以 diveAt 代替)
+    int count;
+} ScriptView;
+
+ScriptId ScriptForType(EnemyType type); // 各敵人種類使用的腳本
+bool ScriptHoming(ScriptId id); // 腳本是否包含 OP_HOME (需要 homeAt)
+uint32_t ScriptStart(ScriptView v, int i, ScriptId id, RVec2 diveAt); // 從頭執行腳本，返回執行的指令數
+uint32_t ScriptRun(ScriptView v, Real dt, RVec2 diveAt); // 移動所有敵人並恢復其腳本一個 tick，返回執行的指令數
+void ScriptAim(ScriptView v, int i, RVec2 diveAt); // 位置被外力改變後重新瞄準目前指令的目標
+
+#endif
@@ -0,0 +1,155 @@
+#include "snapshot.h"
+#include "arena.h"
+#include "autopilot.h"
+#include "ball.h"
+#include "enemy.h"
+#include "explod.h"
+#include "multiball.h"
+#include "player.h"
+#include "projectile.h"
+#include "raylib.h"
+#include "timer.h"
+#include "wave.h"
+#include "world.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#define SNAPSHOT_MAGIC 0x4e534b42u // "BKSN"
+#define SNAPSHOT_VERSION 9u
+
+typedef struct {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t size; // 含標頭的總位元組數
+    float time; // 遊戲時間 (gTimer.Time)
+    uint32_t tick; // 模擬步數 (gTimer.Tick)
+} SnapshotHeader;
+
+typedef StateBlock (*StateBlockFn)(void);
+
+// 依序串接的狀態區塊 (新增模擬狀態時在此登記，並提高 SNAPSHOT_VERSION)
+static const StateBlockFn stateBlocks[] = {
+    PlayerStateBlock,
+    BallStateBlock,
+    MultiballStateBlock,
+    EnemyStateBlock,
+    WaveStateBlock,
+    ExplodStateBlock,
+    ProjectileStateBlock,
+    TimerWheelStateBlock,
+    InputStateBlock,
+    AutopilotStateBlock,
+};
+
+static SnapshotStats stats = { 0 };
+
+/**
+ * @brief 快照所需的位元組數
+ */
+size_t SnapshotSize()
+{
+    size_t size = sizeof(SnapshotHeader);
+    for (size_t i = 0; i < sizeof(stateBlocks) / sizeof(stateBlocks[0]); i++) {
+        size += stateBlocks[i]().size;
+    }
+    return size;
+}
+
+/**
+ * @brief 保存目前狀態
+ */
+size_t SnapshotSave(void* buf, size_t cap)
+{
+    double t0 = GetTime();
+    size_t size = SnapshotSize();
+    if (cap < size) {
+        return 0;
+    }
+    SnapshotHeader header = { SNAPSHOT_MAGIC, SNAPSHOT_VERSION, (uint32_t)size, gTimer.Time(), gTimer.Tick() };
+    uint8_t* p = buf;
+    memcpy(p, &header, sizeof(header));
+    p += sizeof(header);
+    for (size_t i = 0; i < sizeof(stateBlocks) / sizeof(stateBlocks[0]); i++) {
+        StateBlock b = stateBlocks[i]();
+        memcpy(p, b.data, b.size);
+        p += b.size;
+    }
+    stats.saveUs = (GetTime() - t0) * 1e6;
+    return size;
+}
+
+/**
+ * @brief 還原狀態
+ * 先檢查標頭，確認無誤才覆寫任何模擬狀態。
+ */
+bool SnapshotRestore(const void* buf, size_t size)
+{
+    double t0 = GetTime();
+    SnapshotHeader header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, buf, sizeof(header));
+    if (header.magic != SNAPSHOT_MAGIC || header.version != SNAPSHOT_VERSION || header.size != size || size != SnapshotSize()) {
+        printf("Error: Snapshot does not match this build.\n");
+        return false;
+    }
+    const uint8_t* p = (const uint8_t*)buf + sizeof(header);
+    for (size_t i = 0; i < sizeof(stateBlocks) / sizeof(stateBlocks[0]); i++) {
+        StateBlock b = stateBlocks[i]();
+        memcpy(b.data, p, b.size);
+        p += b.size;
+    }
+    gTimer.Seek(header.time, header.tick);
+    stats.restoreUs = (GetTime() - t0) * 1e6;
+    return true;
+}
+
+/**
+ * @brief 寫入檔案
+ */
+bool SnapshotWriteFile(const char* path)
+{
+    size_t size = SnapshotSize();
+    void* buf = FrameAlloc(size, 16); // 暫存於每幀配置器，不使用堆積
+    if (buf == NULL || SnapshotSave(buf, size) == 0) {
+        return false;
+    }
+    FILE* f = fopen(path, "wb");
+    if (f == NULL) {
+        printf("Error: Cannot write snapshot %s\n", path);
+        return false;
+    }
+    bool ok = fwrite(buf, 1, size, f) == size;
+    fclose(f);
+    return ok;
+}
+
+/**
+ * @brief 從檔案讀取並還原
+ */
+bool SnapshotReadFile(const char* path)
+{
+    size_t size = SnapshotSize();
+    void* buf = FrameAlloc(size, 16);
+    if (buf == NULL) {
+        return false;
+    }
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        printf("Error: Cannot read snapshot %s\n", path);
+        return false;
+    }
+    size_t n = fread(buf, 1, size, f);
+    fclose(f);
+    return SnapshotRestore(buf, n);
+}
+
+/**
+ * @brief 取得最近一次保存與還原的耗時
+ */
+SnapshotStats SnapshotGetStats()
+{
+    return stats;
+}
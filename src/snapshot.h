@@ -0,0 +1,28 @@
+#ifndef __SNAPSHOT_H__
+#define __SNAPSHOT_H__
+#include <stdbool.h>
+#include <stddef.h>
+
+// 模擬狀態快照
+// 所有模擬狀態 (玩家、球、敵人、爆炸、產生計時器、輸入與自動駕駛、遊戲時間) 以 memcpy 串接成一塊連續的
+// POD 資料，不含 GPU 紋理等資源。快照只能在同一個執行檔內還原 (版本與結構大小必須一致)。
+
+// 一個模組的模擬狀態所在的記憶體區塊
+typedef struct StateBlock {
+    void* data;
+    size_t size;
+} StateBlock;
+
+typedef struct SnapshotStats {
+    double saveUs; // 最近一次保存耗時 (微秒)
+    double restoreUs; // 最近一次還原耗時 (微秒)
+} SnapshotStats;
+
+size_t SnapshotSize(); // 快照所需的位元組數
+size_t SnapshotSave(void* buf, size_t cap); // 保存目前狀態，返回寫入的位元組數 (空間不足時為 0)
+bool SnapshotRestore(const void* buf, size_t size); // 還原狀態 (只能在幀與幀之間呼叫)
+bool SnapshotWriteFile(const char* path); // 寫入檔案 (當機重現用)
+bool SnapshotReadFile(const char* path); // 從檔案讀取並還原
+SnapshotStats SnapshotGetStats();
+
+#endif
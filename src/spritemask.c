@@ -0,0 +1,175 @@
+#include "spritemask.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <string.h>
+
+// 以目前的列資料重新計算實心像素的外框
+static void FrameBounds(SpriteMaskFrame* f, int cellW, int cellH)
+{
+    int minX = cellW, minY = cellH, maxX = -1, maxY = -1;
+    for (int y = 0; y < cellH; y++) {
+        uint64_t row = f->rows[y];
+        if (row == 0) {
+            continue;
+        }
+        if (y < minY) minY = y;
+        maxY = y;
+        int lo = __builtin_ctzll(row);
+        int hi = 63 - __builtin_clzll(row);
+        if (lo < minX) minX = lo;
+        if (hi > maxX) maxX = hi;
+    }
+    f->minX = (int8_t)minX;
+    f->minY = (int8_t)minY;
+    f->maxX = (int8_t)maxX;
+    f->maxY = (int8_t)maxY;
+}
+
+// 所有影格外框的聯集
+static void MaskBounds(SpriteMask* m)
+{
+    int minX = m->cellW, minY = m->cellH, maxX = -1, maxY = -1;
+    for (int k = 0; k < m->frameCount; k++) {
+        const SpriteMaskFrame* f = &m->frames[k];
+        if (f->minX > f->maxX) {
+            continue; // 空影格
+        }
+        if (f->minX < minX) minX = f->minX;
+        if (f->minY < minY) minY = f->minY;
+        if (f->maxX > maxX) maxX = f->maxX;
+        if (f->maxY > maxY) maxY = f->maxY;
+    }
+    m->minX = (int8_t)minX;
+    m->minY = (int8_t)minY;
+    m->maxX = (int8_t)maxX;
+    m->maxY = (int8_t)maxY;
+}
+
+static void MaskClear(SpriteMask* m, int cellW, int cellH, int frameCount)
+{
+    memset(m, 0, sizeof(*m));
+    m->cellW = cellW;
+    m->cellH = cellH;
+    m->centerW = cellW / 2; // 與 AnimFrameLoad 相同 (整數除法)
+    m->centerH = cellH / 2;
+    m->frameCount = frameCount;
+}
+
+/**
+ * @brief 由圖片的 alpha 產生遮罩 (精靈圖第 0 列的每個單元格為一個影格)
+ * 失敗時 (檔案不存在、尺寸不符) 遮罩內容不變。
+ *
+ * @param m 輸出的遮罩
+ * @param fname 圖片路徑 (與 AnimFrameLoad 相同)
+ * @param cellW 單元格寬度 (不超過 SPRITE_MASK_MAX_SIZE)
+ * @param cellH 單元格高度 (不超過 SPRITE_MASK_MAX_SIZE)
+ * @return 成功時返回 true
+ */
+bool SpriteMaskLoad(SpriteMask* m, const char* fname, int cellW, int cellH)
+{
+    if (cellW <= 0 || cellH <= 0 || cellW > SPRITE_MASK_MAX_SIZE || cellH > SPRITE_MASK_MAX_SIZE) {
+        printf("Warning: Invalid mask cell size (%d, %d) for %s\n", cellW, cellH, fname);
+        return false;
+    }
+    Image img = LoadImage(fname); // 只在 CPU 端解碼，無視窗的批次執行也能使用
+    if (img.data == NULL) {
+        printf("Warning: Failed to load collision mask from %s\n", fname);
+        return false;
+    }
+    int frameCount = img.width / cellW;
+    if (frameCount > SPRITE_MASK_MAX_FRAMES) {
+        frameCount = SPRITE_MASK_MAX_FRAMES;
+    }
+    if (frameCount < 1 || img.height < cellH) {
+        printf("Warning: %s is smaller than one %dx%d cell\n", fname, cellW, cellH);
+        UnloadImage(img);
+        return false;
+    }
+    Color* pixels = LoadImageColors(img);
+    MaskClear(m, cellW, cellH, frameCount);
+    for (int k = 0; k < frameCount; k++) {
+        SpriteMaskFrame* f = &m->frames[k];
+        for (int y = 0; y < cellH; y++) {
+            const Color* src = &pixels[y * img.width + k * cellW];
+            uint64_t row = 0;
+            for (int x = 0; x < cellW; x++) {
+                if (src[x].a >= SPRITE_MASK_ALPHA) {
+                    row |= (uint64_t)1 << x;
+                }
+            }
+            f->rows[y] = row;
+        }
+        FrameBounds(f, cellW, cellH);
+    }
+    MaskBounds(m);
+    UnloadImageColors(pixels);
+    UnloadImage(img);
+    return true;
+}
+
+/**
+ * @brief 單一影格、置中的 w x h 實心矩形
+ */
+void SpriteMaskBox(SpriteMask* m, int cellW, int cellH, int w, int h)
+{
+    MaskClear(m, cellW, cellH, 1);
+    int x0 = (cellW - w) / 2;
+    int y0 = (cellH - h) / 2;
+    uint64_t row = (w >= 64 ? ~(uint64_t)0 : (((uint64_t)1 << w) - 1)) << x0;
+    for (int y = y0; y < y0 + h; y++) {
+        m->frames[0].rows[y] = row;
+    }
+    FrameBounds(&m->frames[0], cellW, cellH);
+    MaskBounds(m);
+}
+
+/**
+ * @brief 單一影格、填滿 size x size 單元格的實心圓 (取像素中心判定)
+ */
+void SpriteMaskDisc(SpriteMask* m, int size)
+{
+    MaskClear(m, size, size, 1);
+    float r = size / 2.0f;
+    for (int y = 0; y < size; y++) {
+        float dy = y + 0.5f - r;
+        for (int x = 0; x < size; x++) {
+            float dx = x + 0.5f - r;
+            if (dx * dx + dy * dy <= r * r) {
+                m->frames[0].rows[y] |= (uint64_t)1 << x;
+            }
+        }
+    }
+    FrameBounds(&m->frames[0], size, size);
+    MaskBounds(m);
+}
+
+/**
+ * @brief 兩個影格是否有重疊的實心像素
+ * 先比較實心外框 (粗略判定)，重疊時才逐列將 b 的列位移到 a 的座標後做 AND。
+ * 外框重疊保證水平位移量小於 64，位移不會超出字寬。
+ *
+ * @param a 影格 a
+ * @param ax a 左上角的像素 X 座標
+ * @param ay a 左上角的像素 Y 座標
+ * @param b 影格 b
+ * @param bx b 左上角的像素 X 座標
+ * @param by b 左上角的像素 Y 座標
+ * @return true 若有重疊
+ */
+bool SpriteMaskOverlap(const SpriteMaskFrame* a, int ax, int ay, const SpriteMaskFrame* b, int bx, int by)
+{
+    if (ax + a->maxX < bx + b->minX || bx + b->maxX < ax + a->minX) {
+        return false;
+    }
+    int y0 = ay + a->minY > by + b->minY ? ay + a->minY : by + b->minY;
+    int y1 = ay + a->maxY < by + b->maxY ? ay + a->maxY : by + b->maxY;
+    int dx = bx - ax; // b 的第 0 欄在 a 中的欄位
+    for (int y = y0; y <= y1; y++) {
+        uint64_t ra = a->rows[y - ay];
+        uint64_t rb = b->rows[y - by];
+        if ((dx >= 0 ? ra & (rb << dx) : (ra << -dx) & rb) != 0) {
+            return true;
+        }
+    }
+    return false;
+}
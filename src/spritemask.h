@@ -0,0 +1,34 @@
+#ifndef __SPRITEMASK_H__
+#define __SPRITEMASK_H__
+#include <stdbool.h>
+#include <stdint.h>
+
+// 像素精確碰撞用的精靈遮罩
+// 載入時由貼圖的 alpha 產生，每個影格每一列壓縮為一個 64 位元字 (位元 x 對應第 x 欄)，
+// 兩個遮罩相交只需對重疊的每一列做一次位移與 AND。只在 CPU 端解碼圖片，不需要視窗。
+
+#define SPRITE_MASK_MAX_SIZE 64 // 單元格的最大寬高 (一列必須放得進 uint64_t)
+#define SPRITE_MASK_MAX_FRAMES 8 // 每張精靈圖的最大影格數 (只取第 0 列)
+#define SPRITE_MASK_ALPHA 128 // alpha 不低於此值的像素視為實心
+
+// 單一影格的遮罩
+typedef struct SpriteMaskFrame {
+    uint64_t rows[SPRITE_MASK_MAX_SIZE]; // 各列的實心像素
+    int8_t minX, minY, maxX, maxY; // 實心像素的外框 (含邊界，空影格時 min > max)
+} SpriteMaskFrame;
+
+// 一張精靈圖的遮罩 (所有世界共用的唯讀資料)
+typedef struct SpriteMask {
+    SpriteMaskFrame frames[SPRITE_MASK_MAX_FRAMES];
+    int cellW, cellH; // 單元格尺寸 (與 AnimFrame 相同)
+    int centerW, centerH; // 單元格中心 (繪製原點)
+    int frameCount; // 影格數量
+    int8_t minX, minY, maxX, maxY; // 所有影格實心外框的聯集 (射線查詢等不分影格的判定使用)
+} SpriteMask;
+
+bool SpriteMaskLoad(SpriteMask* m, const char* fname, int cellW, int cellH); // 由圖片 alpha 產生遮罩
+void SpriteMaskBox(SpriteMask* m, int cellW, int cellH, int w, int h); // 置中的 w x h 實心矩形 (載入失敗時使用)
+void SpriteMaskDisc(SpriteMask* m, int size); // 填滿單元格的實心圓 (載入失敗時使用)
+bool SpriteMaskOverlap(const SpriteMaskFrame* a, int ax, int ay, const SpriteMaskFrame* b, int bx, int by); // 兩個影格 (左上角位於給定像素座標) 是否有重疊的實心像素
+
+#endif
@@ -0,0 +1,167 @@
+#include "statehash.h"
+#include "ball.h"
+#include "enemy.h"
+#include "explod.h"
+#include "multiball.h"
+#include "player.h"
+#include "projectile.h"
+#include "timer.h"
+#include "wave.h"
+#include "world.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+#define HASH_P0 0xa0761d6478bd642full // wyhash 常數
+#define HASH_P1 0xe7037ed1a0b428dbull
+
+typedef struct {
+    FILE* log; // 每個 tick 的雜湊記錄檔 (NULL 表示不記錄)
+    uint64_t last;
+} StateHash;
+
+static StateHash stateHash = { 0 };
+
+// 64x64 -> 128 位元乘法後將高低位元折疊
+static inline uint64_t Mix(uint64_t a, uint64_t b)
+{
+    __uint128_t r = (__uint128_t)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+}
+
+/**
+ * @brief 將一段記憶體累加進雜湊值 (每次處理 16 位元組)
+ */
+uint64_t StateHashBytes(uint64_t h, const void* data, size_t n)
+{
+    const uint8_t* p = data;
+    uint64_t a, b;
+    h ^= n * HASH_P0;
+    while (n >= 16) {
+        memcpy(&a, p, 8);
+        memcpy(&b, p + 8, 8);
+        h = Mix(a ^ HASH_P1, b ^ h);
+        p += 16;
+        n -= 16;
+    }
+    if (n > 0) {
+        uint8_t tail[16] = { 0 };
+        memcpy(tail, p, n);
+        memcpy(&a, tail, 8);
+        memcpy(&b, tail + 8, 8);
+        h = Mix(a ^ HASH_P1, b ^ h);
+    }
+    return Mix(h ^ HASH_P0, HASH_P1);
+}
+
+/**
+ * @brief 計算目前模擬狀態的雜湊值
+ */
+uint64_t StateHashCompute()
+{
+    uint64_t h = STATE_HASH_SEED;
+    h = PlayerStateHash(h);
+    h = BallStateHash(h);
+    h = MultiballStateHash(h);
+    h = EnemyStateHash(h);
+    h = ExplodStateHash(h);
+    h = ProjectileStateHash(h);
+    h = WaveStateHash(h);
+    h = TimerWheelStateHash(h);
+    h = InputStateHash(h);
+    h = AutopilotStateHash(h);
+    return h;
+}
+
+/**
+ * @brief 計算本 tick 的雜湊值並寫入記錄檔
+ */
+void StateHashTick()
+{
+    stateHash.last = StateHashCompute();
+    if (stateHash.log != NULL) {
+        fprintf(stateHash.log, "%" PRIu32 " %016" PRIx64 "\n", gTimer.Tick(), stateHash.last);
+    }
+}
+
+/**
+ * @brief 最近一次 StateHashTick 的結果
+ */
+uint64_t StateHashLast()
+{
+    return stateHash.last;
+}
+
+/**
+ * @brief 開始記錄每個 tick 的雜湊值
+ */
+bool StateHashLogOpen(const char* path)
+{
+    StateHashLogClose();
+    stateHash.log = fopen(path, "w");
+    if (stateHash.log == NULL) {
+        printf("Error: Cannot open hash log %s\n", path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief 關閉記錄檔
+ */
+void StateHashLogClose()
+{
+    if (stateHash.log != NULL) {
+        fclose(stateHash.log);
+        stateHash.log = NULL;
+    }
+}
+
+/**
+ * @brief 讀取記錄檔
+ * 倒帶後同一個 tick 可能出現多次，以最後一筆為準。
+ */
+int StateHashLoadLog(const char* path, uint64_t* hashes, int max)
+{
+    FILE* f = fopen(path, "r");
+    if (f == NULL) {
+        printf("Error: Cannot open hash log %s\n", path);
+        return 0;
+    }
+    memset(hashes, 0, sizeof(uint64_t) * (size_t)max);
+    int n = 0;
+    uint32_t tick;
+    uint64_t hash;
+    while (fscanf(f, "%" SCNu32 " %" SCNx64, &tick, &hash) == 2) {
+        if (tick < (uint32_t)max) {
+            hashes[tick] = hash;
+            if ((int)tick + 1 > n) {
+                n = (int)tick + 1;
+            }
+        }
+    }
+    fclose(f);
+    return n;
+}
+
+/**
+ * @brief 二分搜尋第一個不同的 tick
+ * 狀態一旦分歧就會一直不同 (分歧會傳播到之後的每個 tick)，因此「是否已分歧」對 tick 單調，
+ * 只需比較 O(log n) 筆雜湊值。
+ */
+int StateHashFindDivergence(const uint64_t* a, const uint64_t* b, int n)
+{
+    if (n <= 0 || a[n - 1] == b[n - 1]) {
+        return -1;
+    }
+    int lo = 0, hi = n - 1; // hi 必定已分歧
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (a[mid] != b[mid]) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return lo;
+}
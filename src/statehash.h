@@ -0,0 +1,22 @@
+#ifndef __STATEHASH_H__
+#define __STATEHASH_H__
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 每個 tick 的模擬狀態雜湊 (確定性驗證與不同步偵測)
+// 以 wyhash 風格的 64 位元混合函數逐段累加：敵人位置/速度/路徑索引、球的位置/方向、
+// 玩家板位置/分數、爆炸剩餘時間、輸入與自動駕駛。只涵蓋活動中的實體，成本與實體數量成正比。
+
+#define STATE_HASH_SEED 0x9e3779b97f4a7c15ull
+
+uint64_t StateHashBytes(uint64_t h, const void* data, size_t n); // 將一段記憶體累加進雜湊值
+uint64_t StateHashCompute(); // 計算目前模擬狀態的雜湊值
+void StateHashTick(); // 每個 tick 結尾呼叫：計算雜湊值並寫入記錄檔 (若已開啟)
+uint64_t StateHashLast(); // 最近一次 StateHashTick 的結果
+bool StateHashLogOpen(const char* path); // 開始記錄每個 tick 的雜湊值 ("tick hash" 每行一筆)
+void StateHashLogClose();
+int StateHashLoadLog(const char* path, uint64_t* hashes, int max); // 讀取記錄檔，hashes[tick] = 雜湊值，返回最大 tick + 1
+int StateHashFindDivergence(const uint64_t* a, const uint64_t* b, int n); // 二分搜尋第一個不同的 tick，完全相同時返回 -1
+
+#endif
@@ -0,0 +1,135 @@
+#include "sweep.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// a 是否排在 b 之前 (x 相同時以索引決定，順序唯一)
+static inline bool SweepBefore(const RVec2* pos, uint32_t a, uint32_t b)
+{
+    return pos[a].x < pos[b].x || (pos[a].x == pos[b].x && a < b);
+}
+
+/**
+ * @brief 依目前位置修正順序
+ * 物件數改變時 (敵人在陣列末端產生、移除後往前壓縮)，先丟棄超出範圍的索引、再補上新的索引，
+ * 得到 [0, count) 的排列後以插入排序修正。
+ *
+ * @return 插入排序的移動次數 (順序與位置的不一致程度)
+ */
+uint32_t SweepSort(SweepList* s, const RVec2* pos, int count)
+{
+    uint32_t* order = s->order;
+    if (s->count != count) {
+        int n = 0;
+        for (int k = 0; k < s->count; k++) {
+            if (order[k] < (uint32_t)count) {
+                order[n++] = order[k];
+            }
+        }
+        for (int i = s->count; i < count; i++) {
+            order[n++] = (uint32_t)i;
+        }
+        s->count = count;
+    }
+    uint32_t shifts = 0;
+    for (int k = 1; k < count; k++) {
+        uint32_t v = order[k];
+        int j = k;
+        while (j > 0 && SweepBefore(pos, v, order[j - 1])) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = v;
+        shifts += (uint32_t)(k - j);
+    }
+    return shifts;
+}
+
+// 兩個物件重疊時，各累加一半的重疊量 (沿中心連線往外)，返回是否重疊
+static inline bool SweepPush(const RVec2* pos, uint32_t i, uint32_t j, Real minDist, RealWide minDist2, RVec2* push)
+{
+    RVec2 d = RVec2Sub(pos[j], pos[i]);
+    if (d.y >= minDist || d.y <= -minDist) {
+        return false;
+    }
+    RealWide d2 = RVec2LengthSqr(d);
+    if (d2 >= minDist2) {
+        return false;
+    }
+    Real dist = RSqrtWide(d2);
+    RVec2 n = dist > 0 ? (RVec2) { RDiv(d.x, dist), RDiv(d.y, dist) } : (RVec2) { R(1.0f), 0 }; // 重合時沿 x 分開
+    RVec2 half = RVec2Scale(n, (minDist - dist) / 2);
+    push[i] = RVec2Sub(push[i], half);
+    push[j] = RVec2Add(push[j], half);
+    return true;
+}
+
+/**
+ * @brief 掃描排序後的物件，將重疊對的推開量累加進 push
+ * 須先以 SweepSort 排序；push 由呼叫端清空，套用方式 (比例、上限) 也由呼叫端決定。
+ *
+ * @param tested 累加測試的對數 (基準測試用，可為 NULL)
+ * @return 重疊的對數
+ */
+uint32_t SweepPairs(const SweepList* s, const RVec2* pos, Real minDist, RVec2* push, uint32_t* tested)
+{
+    RealWide minDist2 = RMulWide(minDist, minDist);
+    uint32_t n = 0, contacts = 0;
+    for (int a = 0; a < s->count; a++) {
+        uint32_t i = s->order[a];
+        Real xEnd = pos[i].x + minDist;
+        for (int b = a + 1; b < s->count; b++) {
+            uint32_t j = s->order[b];
+            if (pos[j].x >= xEnd) { // 之後的物件 x 更大
+                break;
+            }
+            n++;
+            contacts += SweepPush(pos, i, j, minDist, minDist2, push);
+        }
+    }
+    if (tested != NULL) {
+        *tested += n;
+    }
+    return contacts;
+}
+
+/**
+ * @brief 將累加的推開量套用到位置上
+ * 每個 tick 只推開重疊量的一部分 (柔性分離)，並限制單次的位移，避免擠在一起的物件一次彈開。
+ */
+void SweepApply(RVec2* pos, const RVec2* push, int count, Real rate, Real maxStep)
+{
+    RealWide maxStep2 = RMulWide(maxStep, maxStep);
+    for (int i = 0; i < count; i++) {
+        if (push[i].x == 0 && push[i].y == 0) {
+            continue;
+        }
+        RVec2 step = RVec2Scale(push[i], rate);
+        if (RVec2LengthSqr(step) > maxStep2) {
+            step = RVec2Scale(RVec2Normalize(step), maxStep);
+        }
+        pos[i] = RVec2Add(pos[i], step);
+    }
+}
+
+/**
+ * @brief 兩兩測試所有物件 (結果與 SweepPairs 相同，只有累加順序不同)
+ */
+uint32_t SweepPairsBrute(const RVec2* pos, int count, Real minDist, RVec2* push, uint32_t* tested)
+{
+    RealWide minDist2 = RMulWide(minDist, minDist);
+    uint32_t n = 0, contacts = 0;
+    for (int i = 0; i < count; i++) {
+        for (int j = i + 1; j < count; j++) {
+            Real dx = pos[j].x - pos[i].x;
+            n++;
+            if (dx >= minDist || dx <= -minDist) {
+                continue;
+            }
+            contacts += SweepPush(pos, (uint32_t)i, (uint32_t)j, minDist, minDist2, push);
+        }
+    }
+    if (tested != NULL) {
+        *tested += n;
+    }
+    return contacts;
+}
@@ -0,0 +1,22 @@
+#ifndef __SWEEP_H__
+#define __SWEEP_H__
+#include "real.h"
+#include <stdint.h>
+
+// 一維掃描與剪除 (sweep and prune)：敵人之間的分離
+// 所有物件的半徑相同，只需依中心的 x 排序；順序跨 tick 保留，移動連貫時前一個 tick 的順序幾乎已排好，
+// 插入排序只需少數幾次移動。掃描時每個物件只與排在後面、x 距離小於 minDist 的物件測試。
+// 排序鍵為 (x, 索引)，結果與前一個 tick 的順序無關 (快照還原後不必保存順序)。
+
+// 依 x 排序的物件順序 (陣列屬於呼叫端，跨 tick 保留)
+typedef struct SweepList {
+    uint32_t* order; // 依 (x, 索引) 排序的物件索引，容量不小於物件數
+    int count; // 上次排序時的物件數
+} SweepList;
+
+uint32_t SweepSort(SweepList* s, const RVec2* pos, int count); // 依目前位置修正順序，返回插入排序的移動次數
+uint32_t SweepPairs(const SweepList* s, const RVec2* pos, Real minDist, RVec2* push, uint32_t* tested); // 將重疊對的推開量累加進 push，返回重疊的對數
+void SweepApply(RVec2* pos, const RVec2* push, int count, Real rate, Real maxStep); // 將推開量乘上 rate (長度不超過 maxStep) 加到位置上
+uint32_t SweepPairsBrute(const RVec2* pos, int count, Real minDist, RVec2* push, uint32_t* tested); // 兩兩測試 (驗證與基準測試的對照)
+
+#endif
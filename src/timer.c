@@ -1,70 +1,352 @@
 #include "timer.h"
+#include "brickout.h"
 #include "raylib.h"
+#include "statehash.h"
+#include "world.h"
+#include <stdio.h>
 
-// 計時器結構體
-typedef struct {
-    float startTime; // 計時器啟動時間(毫秒)
-    float pauseTime; // 暫停時的時間戳(非零表示處於暫停狀態)
-    float time; // 當前幀的時間戳
-    float deltaTime; // 上一幀到當前幀的時間間隔(毫秒)
-} Timer;
+#define WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+#define WHEEL_RANGE (1u << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS))
 
-// 全局計時器實例
-static Timer timer;
+_Static_assert(TIMER_MAX_NODES < TIMER_NIL && TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS < TIMER_NIL, "timer indices must fit in uint16_t");
+
+static TimerCallback callbacks[TIMER_MAX_CALLBACKS]; // 回呼註冊表 (所有世界共用)
+static int callbackCount = 0;
+
+static void wheelReset();
 
 // 初始化計時器
 static void init()
 {
-    timer.startTime = (float)GetTime();
-    timer.pauseTime = 0.0F; // 0表示未暫停
-    timer.time = timer.startTime;
-    timer.deltaTime = 0.0F; // 初始deltaTime為0
+    Timer* timer = &gWorld->timer;
+    timer->startTime = (float)GetTime();
+    timer->pauseTime = 0.0F; // 0表示未暫停
+    timer->time = timer->startTime;
+    timer->deltaTime = 0.0F; // 初始deltaTime為0
+    timer->elapsed = 0.0F;
+    timer->tick = 0;
+    timer->fixedStep = 0.0F;
+    wheelReset();
+}
+
+// 初始化固定步長的計時器 (不呼叫 raylib，可在任何執行緒使用)
+static void initFixed(float step)
+{
+    Timer* timer = &gWorld->timer;
+    timer->startTime = 0.0F;
+    timer->pauseTime = 0.0F;
+    timer->time = 0.0F;
+    timer->deltaTime = 0.0F;
+    timer->elapsed = 0.0F;
+    timer->tick = 0;
+    timer->fixedStep = step;
+    wheelReset();
 }
 
 // 暫停計時器
 static void pause()
 {
+    Timer* timer = &gWorld->timer;
     // 如果已經暫停則不做任何操作
-    if (timer.pauseTime == 0.0F) {
-        timer.pauseTime = (float)GetTime();
+    if (timer->pauseTime == 0.0F) {
+        timer->pauseTime = (float)GetTime();
     }
 }
 
 // 恢復計時器
 static void resume()
 {
+    Timer* timer = &gWorld->timer;
     // 只有當處於暫停狀態時才執行恢復操作
-    if (timer.pauseTime != 0.0F) {
-        float delta = (float)GetTime() - timer.pauseTime;
-        timer.pauseTime = 0.0F; // 重置暫停狀態
-        timer.startTime += delta; // 調整起始時間以補償暫停期間
+    if (timer->pauseTime != 0.0F) {
+        float delta = (float)GetTime() - timer->pauseTime;
+        timer->pauseTime = 0.0F; // 重置暫停狀態
+        timer->startTime += delta; // 調整起始時間以補償暫停期間
     }
 }
 
 // 更新計時器(應在每幀調用)
 static void update()
 {
+    Timer* timer = &gWorld->timer;
+    timer->tick++; // 暫停時模擬仍會執行 (deltaTime 為 0)，因此照樣計數
     // 如果處於暫停狀態，deltaTime應為0
-    if (timer.pauseTime != 0.0F) {
-        timer.deltaTime = 0.0F;
+    if (timer->pauseTime != 0.0F) {
+        timer->deltaTime = 0.0F;
+        return;
+    }
+    if (timer->fixedStep != 0.0F) {
+        timer->deltaTime = timer->fixedStep;
+        timer->elapsed += timer->fixedStep;
         return;
     }
     float ts = (float)GetTime();
-    timer.deltaTime = ts - timer.time;
-    timer.time = ts;
+    timer->deltaTime = ts - timer->time;
+    timer->time = ts;
+    timer->elapsed += timer->deltaTime;
 }
 
 // 獲取上一幀的deltaTime(毫秒)
 static float deltaTime(void)
 {
-    return timer.deltaTime;
+    return gWorld->timer.deltaTime;
+}
+
+// 獲取遊戲時間(秒)，用於由生成時間戳計算動畫影格
+static float elapsedTime(void)
+{
+    return gWorld->timer.elapsed;
+}
+
+// 獲取目前的模擬步數
+static uint32_t tick(void)
+{
+    return gWorld->timer.tick;
+}
+
+// 設定遊戲時間(秒)與模擬步數，還原快照時使用，不影響下一幀的 deltaTime
+static void seek(float time, uint32_t tick)
+{
+    Timer* timer = &gWorld->timer;
+    timer->elapsed = time;
+    timer->tick = tick;
+}
+
+// ----------------------------------------------------------------------------------
+// 排程 (階層式時間輪)
+// ----------------------------------------------------------------------------------
+
+// 清空時間輪 (只重設槽位，節點在第一次使用時才初始化，環境頻繁重設時不必寫入整個節點池)
+static void wheelReset()
+{
+    TimerWheel* wheel = &gWorld->timer.wheel;
+    for (int i = 0; i < TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS; i++) {
+        wheel->slots[i] = TIMER_NIL;
+    }
+    wheel->freeList = TIMER_NIL;
+    wheel->used = 0;
+    wheel->pending = 0;
+    wheel->now = 0;
+}
+
+// 取得未使用的節點：先從空閒串列，再從未使用過的節點
+static uint16_t wheelAlloc(TimerWheel* wheel)
+{
+    uint16_t n = wheel->freeList;
+    if (n != TIMER_NIL) {
+        wheel->freeList = wheel->nodes[n].next;
+    } else if (wheel->used < TIMER_MAX_NODES) {
+        n = wheel->used++;
+        wheel->nodes[n].gen = 1;
+    } else {
+        return TIMER_NIL;
+    }
+    wheel->pending++;
+    return n;
+}
+
+// 依與目前 tick 的距離放入對應層級的槽位 (距離越遠層級越高，每層的槽位涵蓋 2^(BITS*層級) tick)
+static void wheelLink(TimerWheel* wheel, uint16_t n)
+{
+    TimerNode* node = &wheel->nodes[n];
+    uint32_t delta = node->expire - wheel->now;
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1u << (TIMER_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+    uint16_t slot = (uint16_t)(level * TIMER_WHEEL_SLOTS + ((node->expire >> (TIMER_WHEEL_BITS * level)) & WHEEL_MASK));
+    node->slot = slot;
+    node->prev = TIMER_NIL;
+    node->next = wheel->slots[slot];
+    if (node->next != TIMER_NIL) {
+        wheel->nodes[node->next].prev = n;
+    }
+    wheel->slots[slot] = n;
+}
+
+static void wheelUnlink(TimerWheel* wheel, uint16_t n)
+{
+    TimerNode* node = &wheel->nodes[n];
+    if (node->prev != TIMER_NIL) {
+        wheel->nodes[node->prev].next = node->next;
+    } else {
+        wheel->slots[node->slot] = node->next;
+    }
+    if (node->next != TIMER_NIL) {
+        wheel->nodes[node->next].prev = node->prev;
+    }
+    node->slot = TIMER_NIL;
+}
+
+// 放回空閒串列並提高世代，使舊的代號失效
+static void wheelFree(TimerWheel* wheel, uint16_t n)
+{
+    TimerNode* node = &wheel->nodes[n];
+    node->gen = (uint16_t)(node->gen + 1 != 0 ? node->gen + 1 : 1);
+    node->next = wheel->freeList;
+    wheel->freeList = n;
+    wheel->pending--;
+}
+
+// 註冊回呼函數 (重複註冊同一個函數不會佔用新的索引)
+static void timerRegister(TimerCallback fn)
+{
+    for (int i = 0; i < callbackCount; i++) {
+        if (callbacks[i] == fn) {
+            return;
+        }
+    }
+    if (callbackCount >= TIMER_MAX_CALLBACKS) {
+#ifdef DEBUG
+        printf("Warning: timer callback table is full.\n");
+#endif
+        return;
+    }
+    callbacks[callbackCount++] = fn;
+}
+
+static TimerHandle timerAdd(uint32_t delay, uint32_t interval, TimerCallback fn, uint32_t arg)
+{
+    TimerWheel* wheel = &gWorld->timer.wheel;
+    int cb = 0;
+    while (cb < callbackCount && callbacks[cb] != fn) {
+        cb++;
+    }
+    uint16_t n = cb < callbackCount ? wheelAlloc(wheel) : TIMER_NIL;
+    if (n == TIMER_NIL) {
+#ifdef DEBUG
+        printf("Warning: cannot schedule timer (%s).\n", cb == callbackCount ? "callback not registered" : "pool is full");
+#endif
+        return TIMER_INVALID;
+    }
+    if (delay < 1) { // 本 tick 的槽位已經取出，最早只能排在下一個 tick
+        delay = 1;
+    }
+    if (delay > WHEEL_RANGE - 1) {
+        delay = WHEEL_RANGE - 1;
+    }
+    TimerNode* node = &wheel->nodes[n];
+    node->expire = wheel->now + delay;
+    node->interval = interval < WHEEL_RANGE ? interval : WHEEL_RANGE - 1;
+    node->arg = arg;
+    node->callback = (uint8_t)cb;
+    wheelLink(wheel, n);
+    return ((TimerHandle)node->gen << 16) | n;
+}
+
+// delay tick 之後執行一次
+static TimerHandle timerSchedule(uint32_t delay, TimerCallback fn, uint32_t arg)
+{
+    return timerAdd(delay, 0, fn, arg);
+}
+
+// 每 interval tick 執行一次 (第一次在 interval tick 之後)
+static TimerHandle timerEvery(uint32_t interval, TimerCallback fn, uint32_t arg)
+{
+    if (interval < 1) {
+        interval = 1;
+    }
+    return timerAdd(interval, interval, fn, arg);
+}
+
+// 取消排程 (可在回呼中取消自己或其他計時器)
+static bool timerCancel(TimerHandle handle)
+{
+    TimerWheel* wheel = &gWorld->timer.wheel;
+    uint16_t n = (uint16_t)(handle & 0xFFFF);
+    if (n >= wheel->used) {
+        return false;
+    }
+    TimerNode* node = &wheel->nodes[n];
+    if (node->gen != (uint16_t)(handle >> 16) || node->slot == TIMER_NIL) {
+        return false;
+    }
+    wheelUnlink(wheel, n);
+    wheelFree(wheel, n);
+    return true;
+}
+
+// 下層時間輪轉完一圈時，把上層目前槽位的節點依剩餘距離重新分配到下層
+static void wheelCascade(TimerWheel* wheel)
+{
+    for (int level = 1; level < TIMER_WHEEL_LEVELS; level++) {
+        if ((wheel->now & ((1u << (TIMER_WHEEL_BITS * level)) - 1)) != 0) {
+            break;
+        }
+        uint16_t slot = (uint16_t)(level * TIMER_WHEEL_SLOTS + ((wheel->now >> (TIMER_WHEEL_BITS * level)) & WHEEL_MASK));
+        uint16_t n = wheel->slots[slot];
+        wheel->slots[slot] = TIMER_NIL;
+        while (n != TIMER_NIL) {
+            uint16_t next = wheel->nodes[n].next;
+            wheelLink(wheel, n);
+            n = next;
+        }
+    }
+}
+
+// 時間輪前進一個 tick 並執行到期的回呼
+// 每次從槽位開頭取出一個節點後才呼叫回呼，回呼中排程或取消其他計時器都是安全的。
+static void timerAdvance()
+{
+    TimerWheel* wheel = &gWorld->timer.wheel;
+    wheel->now++;
+    wheelCascade(wheel);
+    uint16_t slot = (uint16_t)(wheel->now & WHEEL_MASK);
+    while (wheel->slots[slot] != TIMER_NIL) {
+        uint16_t n = wheel->slots[slot];
+        TimerNode* node = &wheel->nodes[n];
+        TimerCallback fn = callbacks[node->callback];
+        uint32_t arg = node->arg;
+        wheelUnlink(wheel, n);
+        if (node->interval != 0) { // 重複的計時器先排入下一次，回呼中可以取消
+            node->expire = wheel->now + node->interval;
+            wheelLink(wheel, n);
+        } else {
+            wheelFree(wheel, n);
+        }
+        fn(arg);
+    }
+}
+
+// 排程中的計時器 (快照用)
+StateBlock TimerWheelStateBlock()
+{
+    return (StateBlock) { &gWorld->timer.wheel, sizeof(TimerWheel) };
+}
+
+/**
+ * @brief 將時間輪與排程中的計時器累加進雜湊值
+ * 依槽位順序走訪各串列 (同一槽位到期時依串列順序執行)，每個節點累加索引、世代、到期 tick、間隔、參數與回呼。
+ */
+uint64_t TimerWheelStateHash(uint64_t h)
+{
+    const TimerWheel* wheel = &gWorld->timer.wheel;
+    uint32_t head[2] = { wheel->now, wheel->pending };
+    h = StateHashBytes(h, head, sizeof(head));
+    for (int s = 0; s < TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS; s++) {
+        for (uint16_t n = wheel->slots[s]; n != TIMER_NIL; n = wheel->nodes[n].next) {
+            const TimerNode* node = &wheel->nodes[n];
+            uint32_t key[5] = { (uint32_t)s << 16 | n, (uint32_t)node->gen << 8 | node->callback, node->expire, node->interval, node->arg };
+            h = StateHashBytes(h, key, sizeof(key));
+        }
+    }
+    return h;
 }
 
 // 導出的計時器接口
 GameTimer gTimer = {
     .Init = init,
+    .InitFixed = initFixed,
     .Pause = pause,
     .Resume = resume,
     .Update = update,
     .DeltaTime = deltaTime,
+    .Time = elapsedTime,
+    .Tick = tick,
+    .Seek = seek,
+    .Register = timerRegister,
+    .Schedule = timerSchedule,
+    .Every = timerEvery,
+    .Cancel = timerCancel,
+    .Advance = timerAdvance,
 };
\ No newline at end of file
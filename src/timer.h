@@ -1,14 +1,78 @@
 #ifndef __TIMER_H__
 #define __TIMER_H__
+#include "snapshot.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#define TIMER_TICK_RATE 60 // 排程以 tick 計算 (與固定步長 1/60 秒、目標幀率一致)
+#define TIMER_SECONDS(s) ((uint32_t)((s) * TIMER_TICK_RATE + 0.5f)) // 秒轉換為 tick
+#define TIMER_WHEEL_BITS 6 // 每層時間輪的槽位數為 2^TIMER_WHEEL_BITS
+#define TIMER_WHEEL_LEVELS 3 // 可排程範圍為 2^(BITS*LEVELS) tick (約 72 分鐘)
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_MAX_NODES 2048 // 每個世界同時排程中的計時器數量上限
+#define TIMER_MAX_CALLBACKS 32 // 可註冊的回呼函數數量上限
+#define TIMER_NIL 0xFFFF // 空串列
+#define TIMER_INVALID 0u // 無效的計時器代號 (排程失敗)
+
+typedef uint32_t TimerHandle; // 計時器代號 (世代 << 16 | 節點索引)，節點重複使用後舊代號自動失效
+typedef void (*TimerCallback)(uint32_t arg); // 到期時呼叫 (gWorld 為排程的世界)
+
+// 時間輪節點
+typedef struct TimerNode {
+    uint32_t expire; // 到期的 tick
+    uint32_t interval; // 重複間隔 (tick)，0 表示只執行一次
+    uint32_t arg; // 傳給回呼函數的參數
+    uint16_t next; // 同一槽位的下一個節點 (未使用時為空閒串列的下一個)
+    uint16_t prev; // 同一槽位的前一個節點 (TIMER_NIL 表示為串列開頭)
+    uint16_t slot; // 所在槽位 (層級 * 槽位數 + 槽位)，TIMER_NIL 表示未排程
+    uint16_t gen; // 世代 (不為 0)
+    uint8_t callback; // 註冊表中的回呼索引 (不保存函數指標，快照跨行程仍有效)
+} TimerNode;
+
+// 階層式時間輪 (每個世界一個，屬於快照)
+// 每個 tick 只取出最低層目前槽位的節點；上層的槽位只在下層轉完一圈時重新分配一次。
+typedef struct TimerWheel {
+    uint16_t slots[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS]; // 各槽位的節點串列開頭
+    TimerNode nodes[TIMER_MAX_NODES];
+    uint16_t freeList; // 已釋放節點串列的開頭
+    uint16_t used; // [0, used) 的節點曾經使用過 (其餘尚未初始化)
+    uint16_t pending; // 排程中的節點數
+    uint32_t now; // 時間輪目前的 tick (Advance 的呼叫次數)
+} TimerWheel;
+
+// 計時器結構體 (每個 GameWorld 各有一個，gTimer 操作目前世界的計時器)
+typedef struct {
+    float startTime; // 計時器啟動時間(毫秒)
+    float pauseTime; // 暫停時的時間戳(非零表示處於暫停狀態)
+    float time; // 當前幀的時間戳
+    float deltaTime; // 上一幀到當前幀的時間間隔(毫秒)
+    float elapsed; // 遊戲時間: 所有 deltaTime 的累加 (不含暫停期間)
+    uint32_t tick; // 模擬步數: Update 的呼叫次數
+    float fixedStep; // 非零時每次 Update 固定前進此秒數，不讀取實際時間 (無視窗的批次執行)
+    TimerWheel wheel; // 排程中的回呼
+} Timer;
 
 typedef struct {
     void (*Init)(void);
+    void (*InitFixed)(float step);
     void (*Pause)(void);
     void (*Resume)(void);
     void (*Update)(void);
     float (*DeltaTime)(void);
+    float (*Time)(void);
+    uint32_t (*Tick)(void);
+    void (*Seek)(float time, uint32_t tick);
+    // 排程 API：回呼須先以 Register 註冊 (所有世界共用，建立世界之前依固定順序呼叫)
+    void (*Register)(TimerCallback fn);
+    TimerHandle (*Schedule)(uint32_t delay, TimerCallback fn, uint32_t arg); // delay tick 之後執行一次
+    TimerHandle (*Every)(uint32_t interval, TimerCallback fn, uint32_t arg); // 每 interval tick 執行一次
+    bool (*Cancel)(TimerHandle handle); // 取消排程，代號已失效時返回 false
+    void (*Advance)(void); // 時間輪前進一個 tick 並執行到期的回呼 (由 WorldStep 呼叫)
 } GameTimer;
 
 extern GameTimer gTimer;
 
-#endif
\ No newline at end of file
+StateBlock TimerWheelStateBlock(); // 排程中的計時器 (快照用)
+uint64_t TimerWheelStateHash(uint64_t h); // 將排程中的計時器累加進雜湊值
+
+#endif
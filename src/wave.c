@@ -0,0 +1,341 @@
+#include "wave.h"
+#include "brickout.h"
+#include "event.h"
+#include "statehash.h"
+#include "timer.h"
+#include "world.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define WAVE_LINE_MAX 256
+
+_Static_assert((uint32_t)WAVE_MAX_SECONDS * TIMER_TICK_RATE < (1u << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)), "WAVE_MAX_SECONDS exceeds the timer wheel range");
+
+// 內建時間軸：每秒在隨機路徑上產生一個隨機敵人 (沒有時間軸檔案時使用)
+static const WaveTimeline defaultTimeline = {
+    .entries = { { TIMER_TICK_RATE, WAVE_RANDOM_TYPE, WAVE_RANDOM_PATH, 1, 0, R(200.0f) } },
+    .count = 1,
+    .loopTicks = TIMER_TICK_RATE,
+    .loopScale = R(1.0f),
+};
+
+static WaveTimeline loadedTimeline; // 最後一次成功載入的時間軸
+static const WaveTimeline* timeline = &defaultTimeline; // 所有世界共用 (只在建立世界之前切換)
+
+static const char* const typeNames[ENEMY_NUMS] = { "*", "fly", "bug", "shit", "cake" };
+
+// ----------------------------------------------------------------------------------
+// 時間軸檔案
+// ----------------------------------------------------------------------------------
+
+static int ParseType(const char* s)
+{
+    for (int i = 0; i < ENEMY_NUMS; i++) {
+        if (strcmp(s, typeNames[i]) == 0) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static int ParsePath(const char* s)
+{
+    if (strcmp(s, "*") == 0) {
+        return WAVE_RANDOM_PATH;
+    }
+    char* end;
+    long path = strtol(s, &end, 10);
+    if (end == s || *end != '\0' || path < 0 || path >= MAX_PATHS) {
+        return -1;
+    }
+    return (int)path;
+}
+
+// 秒轉換為 tick (四捨五入)，超出範圍時返回 false
+static bool SecondsToTicks(double sec, uint32_t limit, uint32_t* ticks)
+{
+    if (!(sec >= 0.0) || sec * TIMER_TICK_RATE + 0.5 > (double)limit) {
+        return false;
+    }
+    *ticks = (uint32_t)(sec * TIMER_TICK_RATE + 0.5);
+    return true;
+}
+
+/**
+ * @brief 載入並驗證時間軸檔案
+ * 每行一個項目：時間(秒) 種類(fly|bug|shit|cake|*) 路徑(0-4|*) 速度 數量 間隔(秒)
+ * 另可用一行「loop 週期(秒) 速度倍率」讓時間軸循環，每次循環後速度乘上倍率。
+ * # 之後為註解。任何一行不合法時輸出檔名與行號，並保留目前的時間軸。
+ *
+ * @param fname 時間軸檔案路徑
+ * @return 成功時返回 true
+ */
+bool WaveLoad(const char* fname)
+{
+    FILE* f = fopen(fname, "r");
+    if (f == NULL) {
+        printf("Wave file %s: cannot open\n", fname);
+        return false;
+    }
+    WaveTimeline parsed = { .count = 0, .loopTicks = 0, .loopScale = R(1.0f) };
+    char line[WAVE_LINE_MAX];
+    int lineNo = 0;
+    const char* error = NULL;
+    while (error == NULL && fgets(line, sizeof(line), f) != NULL) {
+        lineNo++;
+        char* comment = strchr(line, '#');
+        if (comment != NULL) {
+            *comment = '\0';
+        }
+        char word[3][32];
+        double sec, speed, interval;
+        int count;
+        char* p = line;
+        while (isspace((unsigned char)*p)) {
+            p++;
+        }
+        if (*p == '\0') {
+            continue;
+        }
+        if (strncmp(p, "loop", 4) == 0 && isspace((unsigned char)p[4])) {
+            double scale;
+            if (sscanf(p + 4, "%lf %lf %31s", &sec, &scale, word[0]) != 2) {
+                error = "expected: loop <period> <speedScale>";
+            } else if (!SecondsToTicks(sec, WAVE_MAX_SECONDS * TIMER_TICK_RATE, &parsed.loopTicks) || parsed.loopTicks == 0) {
+                error = "loop period out of range";
+            } else if (!(scale > 0.0 && scale <= 10.0)) {
+                error = "loop speed scale must be in (0, 10]";
+            } else {
+                parsed.loopScale = RFromFloat((float)scale);
+            }
+            continue;
+        }
+        if (sscanf(p, "%lf %31s %31s %lf %d %lf %31s", &sec, word[0], word[1], &speed, &count, &interval, word[2]) != 6) {
+            error = "expected: <time> <type> <path> <speed> <count> <interval>";
+            continue;
+        }
+        WaveEntry* e = &parsed.entries[parsed.count];
+        int type = ParseType(word[0]);
+        int path = ParsePath(word[1]);
+        uint32_t intervalTicks = 0;
+        if (parsed.count >= WAVE_MAX_ENTRIES) {
+            error = "too many entries";
+        } else if (!SecondsToTicks(sec, WAVE_MAX_SECONDS * TIMER_TICK_RATE, &e->tick)) {
+            error = "time out of range";
+        } else if (type < 0) {
+            error = "unknown enemy type";
+        } else if (path < 0) {
+            error = "path out of range";
+        } else if (!(speed > 0.0 && speed <= WAVE_MAX_SPEED)) {
+            error = "speed out of range";
+        } else if (count < 1 || count > MAX_ENEMYS) {
+            error = "count out of range";
+        } else if (!SecondsToTicks(interval, UINT16_MAX, &intervalTicks)) {
+            error = "interval out of range";
+        } else {
+            e->eType = (uint8_t)type;
+            e->path = (uint8_t)path;
+            e->count = (uint16_t)count;
+            e->interval = (uint16_t)intervalTicks;
+            e->speed = RFromFloat((float)speed);
+            parsed.count++;
+        }
+    }
+    fclose(f);
+    if (error == NULL && parsed.count == 0) {
+        error = "no entries";
+    }
+    // 穩定排序 (插入排序)：同一時間的項目維持檔案中的順序
+    for (int i = 1; error == NULL && i < parsed.count; i++) {
+        WaveEntry e = parsed.entries[i];
+        int j = i;
+        for (; j > 0 && parsed.entries[j - 1].tick > e.tick; j--) {
+            parsed.entries[j] = parsed.entries[j - 1];
+        }
+        parsed.entries[j] = e;
+    }
+    if (error == NULL && parsed.loopTicks != 0 && parsed.entries[parsed.count - 1].tick >= parsed.loopTicks) {
+        error = "loop period must be longer than the last entry time";
+        lineNo = 0;
+    }
+    if (error != NULL) {
+        if (lineNo > 0) {
+            printf("Wave file %s:%d: %s\n", fname, lineNo, error);
+        } else {
+            printf("Wave file %s: %s\n", fname, error);
+        }
+        return false;
+    }
+    loadedTimeline = parsed;
+    timeline = &loadedTimeline;
+#ifdef DEBUG
+    printf("載入波次時間軸 %s：%d 個項目，循環 %u tick\n", fname, parsed.count, parsed.loopTicks);
+#endif
+    return true;
+}
+
+void WaveUseDefault()
+{
+    timeline = &defaultTimeline;
+}
+
+const WaveTimeline* WaveTimelineGet()
+{
+    return timeline;
+}
+
+// ----------------------------------------------------------------------------------
+// 波次 (以 gTimer 排程)
+// ----------------------------------------------------------------------------------
+
+// 返回 [min, max] 範圍內的亂數
+static int WaveRandom(WaveState* ws, int min, int max)
+{
+    uint32_t x = ws->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    ws->rng = x;
+    return min + (int)(x % (uint32_t)(max - min + 1));
+}
+
+static void PushSpawn(const WaveBurst* burst, int count)
+{
+    EventPush((GameEvent) { .type = EVENT_SPAWN, .spawn = { burst->eType, burst->path, (uint16_t)count, burst->speed } });
+}
+
+// 波次計時器到期：產生一個敵人，全部產生後取消重複的計時器
+static void WaveOnBurst(uint32_t slot)
+{
+    WaveBurst* burst = &gWorld->waves.bursts[slot];
+    PushSpawn(burst, 1);
+    if (--burst->remaining == 0) {
+        gTimer.Cancel(burst->timer);
+    }
+}
+
+// 項目速度乘上目前的倍率，不超過 WAVE_MAX_SPEED (以 RealWide 比較，定點模式下不會溢位)
+static Real ScaledSpeed(Real speed, Real scale)
+{
+    RealWide scaled = RMulWide(speed, scale);
+    return scaled < R(WAVE_MAX_SPEED) ? RNarrow(scaled) : R(WAVE_MAX_SPEED);
+}
+
+// 開始一個項目的波次：interval 為 0 時一次產生全部，否則先產生一個，其餘每 interval tick 產生一個
+static void StartBurst(WaveState* ws, const WaveEntry* e)
+{
+    WaveBurst burst = {
+        .eType = e->eType != WAVE_RANDOM_TYPE ? e->eType : (uint8_t)WaveRandom(ws, ENEMY_FLY, ENEMY_NUMS - 1),
+        .path = e->path != WAVE_RANDOM_PATH ? e->path : (uint8_t)WaveRandom(ws, 0, MAX_PATHS - 1),
+        .remaining = e->count,
+        .speed = ScaledSpeed(e->speed, ws->speedScale),
+    };
+    if (e->interval == 0 || burst.remaining == 1) {
+        PushSpawn(&burst, burst.remaining);
+        return;
+    }
+    PushSpawn(&burst, 1);
+    burst.remaining--;
+    int slot = 0;
+    while (slot < WAVE_MAX_BURSTS && ws->bursts[slot].remaining != 0) {
+        slot++;
+    }
+    if (slot < WAVE_MAX_BURSTS) {
+        burst.timer = gTimer.Every(e->interval, WaveOnBurst, (uint32_t)slot);
+    }
+    if (slot == WAVE_MAX_BURSTS || burst.timer == TIMER_INVALID) { // 無法排程時一次產生剩餘的敵人，而不是遺失
+#ifdef DEBUG
+        if (gWorld->debugLog) {
+            printf("警告：無法排程波次，一次產生 %d 個敵人。\n", burst.remaining);
+        }
+#endif
+        PushSpawn(&burst, burst.remaining);
+        return;
+    }
+    ws->bursts[slot] = burst;
+}
+
+// 游標到期：開始目前的項目與同一時間的項目，再排程到下一個項目 (或下一次循環)
+static void WaveOnCursor(uint32_t arg)
+{
+    (void)arg;
+    WaveState* ws = &gWorld->waves;
+    for (;;) {
+        const WaveEntry* e = &timeline->entries[ws->entry];
+        StartBurst(ws, e);
+        uint32_t delay;
+        if (++ws->entry < timeline->count) {
+            delay = timeline->entries[ws->entry].tick - e->tick;
+        } else if (timeline->loopTicks == 0) { // 時間軸播放完畢
+            return;
+        } else {
+            ws->entry = 0;
+            ws->loop++;
+            ws->speedScale = ScaledSpeed(ws->speedScale, timeline->loopScale); // 倍率本身也設上限，循環再多次也不會溢位
+            delay = timeline->loopTicks - e->tick + timeline->entries[0].tick;
+#ifdef DEBUG
+            if (gWorld->debugLog && timeline->loopScale != R(1.0f)) {
+                printf("波次循環 %u，速度倍率 %.2f\n", ws->loop, RToFloat(ws->speedScale));
+            }
+#endif
+        }
+        if (delay > 0) {
+            gTimer.Schedule(delay, WaveOnCursor, 0);
+            return;
+        }
+    }
+}
+
+/**
+ * @brief 註冊波次使用的計時器回呼 (所有世界共用，建立世界之前呼叫一次)
+ */
+void WaveTimerInit()
+{
+    gTimer.Register(WaveOnCursor);
+    gTimer.Register(WaveOnBurst);
+}
+
+/**
+ * @brief 從頭開始播放目前世界的時間軸 (須在 gTimer 初始化之後呼叫)
+ *
+ * @param seed 隨機種類/路徑的亂數種子 (0 會被替換為 1)
+ */
+void WaveReset(uint32_t seed)
+{
+    WaveState* ws = &gWorld->waves;
+    *ws = (WaveState) { .speedScale = R(1.0f), .rng = seed != 0 ? seed : 1u };
+    gTimer.Schedule(timeline->entries[0].tick, WaveOnCursor, 0);
+}
+
+/**
+ * @brief 將波次進度與進行中的波次累加進雜湊值 (逐欄位，不含結構的填充位元組)
+ */
+uint64_t WaveStateHash(uint64_t h)
+{
+    const WaveState* ws = &gWorld->waves;
+    h = StateHashBytes(h, &ws->entry, sizeof(ws->entry));
+    h = StateHashBytes(h, &ws->loop, sizeof(ws->loop));
+    h = StateHashBytes(h, &ws->speedScale, sizeof(ws->speedScale));
+    h = StateHashBytes(h, &ws->rng, sizeof(ws->rng));
+    for (int i = 0; i < WAVE_MAX_BURSTS; i++) {
+        const WaveBurst* b = &ws->bursts[i];
+        if (b->remaining == 0) {
+            continue;
+        }
+        uint32_t key[2] = { (uint32_t)i << 16 | b->eType << 8 | b->path, b->remaining };
+        h = StateHashBytes(h, key, sizeof(key));
+        h = StateHashBytes(h, &b->speed, sizeof(b->speed));
+        h = StateHashBytes(h, &b->timer, sizeof(b->timer));
+    }
+    return h;
+}
+
+/**
+ * @brief 波次進度 (快照用；排程中的計時器由 TimerWheelStateBlock 保存)
+ */
+StateBlock WaveStateBlock()
+{
+    return (StateBlock) { &gWorld->waves, sizeof(WaveState) };
+}
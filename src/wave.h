@@ -0,0 +1,67 @@
+#ifndef __WAVE_H__
+#define __WAVE_H__
+#include "enemy.h"
+#include "real.h"
+#include "snapshot.h"
+#include "timer.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// 敵人波次時間軸
+// 以資料描述「何時、在哪條路徑、產生幾個什麼敵人」，取代每幀累加計時器的產生方式。
+// 時間軸所有世界共用 (載入後唯讀)；每個世界以 gTimer 排程下一個到期的項目與進行中的波次，
+// 每個 tick 的成本與時間軸長度無關。時間以 tick 計算 (TIMER_TICK_RATE Hz)，定點模式下是確定性的。
+
+#define WAVE_MAX_ENTRIES 256 // 時間軸的項目數上限
+#define WAVE_MAX_SECONDS 3600 // 項目時間與循環週期的上限 (秒)，須小於時間輪可排程的範圍
+#define WAVE_MAX_SPEED (REACH_THRESH_PX * 2 * TIMER_TICK_RATE) // 敵人巡航速度上限 (像素/秒，波次速度與循環倍率的乘積也不超過)；不越過路徑點由腳本的 MoveToward 保證，與此上限無關
+#define WAVE_RANDOM_TYPE ENEMY_NONE // 隨機敵人種類
+#define WAVE_RANDOM_PATH 0xFF // 隨機路徑
+
+#define WAVE_MAX_BURSTS 32 // 同時進行中 (有間隔) 的波次數量上限
+
+// 時間軸上的一個項目：在 tick 時開始，每隔 interval tick 產生一個，共 count 個 (interval 為 0 時一次產生)
+typedef struct WaveEntry {
+    uint32_t tick; // 相對於循環開始的 tick
+    uint8_t eType; // 敵人種類 (WAVE_RANDOM_TYPE 表示每一波隨機)
+    uint8_t path; // 路徑索引 (WAVE_RANDOM_PATH 表示每一波隨機)
+    uint16_t count; // 敵人數量
+    uint16_t interval; // 同一波敵人之間的間隔 (tick)
+    Real speed; // 移動速度
+} WaveEntry;
+
+// 依時間排序的時間軸
+typedef struct WaveTimeline {
+    WaveEntry entries[WAVE_MAX_ENTRIES];
+    int count;
+    uint32_t loopTicks; // 循環週期 (tick)，0 表示播放一次
+    Real loopScale; // 每次循環後速度乘上的倍率 (難度曲線)
+} WaveTimeline;
+
+// 進行中的波次 (remaining 為 0 表示未使用)
+typedef struct WaveBurst {
+    uint8_t eType;
+    uint8_t path;
+    uint16_t remaining; // 尚未產生的敵人數
+    Real speed; // 已乘上難度倍率的速度
+    TimerHandle timer; // 每 interval tick 產生一個的重複計時器
+} WaveBurst;
+
+// 每個世界的波次進度 (屬於快照；排程中的計時器在 gTimer 的時間輪)
+typedef struct WaveState {
+    WaveBurst bursts[WAVE_MAX_BURSTS];
+    uint16_t entry; // 游標：下一個到期的項目索引
+    uint32_t loop; // 已完成的循環次數
+    Real speedScale; // 目前的速度倍率 (不超過 WAVE_MAX_SPEED，避免定點數溢位)
+    uint32_t rng; // xorshift32 亂數狀態 (不可為 0)
+} WaveState;
+
+bool WaveLoad(const char* fname); // 載入並驗證時間軸檔案，失敗時保留目前的時間軸
+void WaveUseDefault(); // 使用內建時間軸 (每秒一個隨機敵人)
+const WaveTimeline* WaveTimelineGet(); // 目前使用中的時間軸
+void WaveTimerInit(); // 註冊計時器回呼 (建立世界之前呼叫一次)
+void WaveReset(uint32_t seed); // 從頭開始播放目前世界的時間軸 (到期的項目寫入 EVENT_SPAWN 事件)
+StateBlock WaveStateBlock(); // 波次進度 (快照用)
+uint64_t WaveStateHash(uint64_t h); // 將波次進度累加進雜湊值
+
+#endif
@@ -0,0 +1,94 @@
+#include "world.h"
+#include "statehash.h"
+#include <pthread.h>
+
+_Thread_local GameWorld* gWorld = NULL;
+
+static pthread_once_t sharedOnce = PTHREAD_ONCE_INIT; // 共用唯讀資料的初始化旗標
+
+// 建立所有世界共用的計時器回呼註冊表 (註冊順序固定，快照中的回呼索引才一致；路徑表在建置時產生)
+// 與碰撞遮罩 (由貼圖 alpha 產生，有無視窗都相同)
+static void WorldSharedInit()
+{
+    WaveTimerInit();
+    ExplodTimerInit();
+    EnemyMaskInit();
+    BallMaskInit();
+    ProjectileMaskInit();
+}
+
+/**
+ * @brief 將世界綁定到目前執行緒
+ * 之後所有子系統函數 (Update、HandleEvents、StateBlock 等) 都作用在此世界上。
+ */
+void WorldBind(GameWorld* world)
+{
+    gWorld = world;
+}
+
+/**
+ * @brief 綁定並重設世界
+ *
+ * @param world 要初始化的世界
+ * @param seed 波次時間軸的亂數種子 (隨機敵人種類與路徑)
+ * @param fixedStep 每 tick 的固定秒數，0 表示使用實際時間 (需要 raylib 視窗)
+ */
+void WorldInit(GameWorld* world, uint32_t seed, float fixedStep)
+{
+    pthread_once(&sharedOnce, WorldSharedInit); // 多個執行緒同時初始化世界時也只建立一次
+    WorldBind(world);
+    if (fixedStep > 0.0f) { // 先清空時間輪，各子系統重設時才能排程計時器
+        gTimer.InitFixed(fixedStep);
+    } else {
+        gTimer.Init();
+    }
+    EventInit();
+    EnemyReset();
+    RaycastBuild(); // 清空查詢格子
+    WaveReset(seed);
+    PlayerReset(PADDLE_W, PADDLE_H);
+    BallReset();
+    MultiballReset(); // 依主球的初始位置排列
+    ExplodReset();
+    ProjectileReset();
+    world->input = (GameInput) { 0 };
+    world->autopilot = (Autopilot) { 0 };
+    world->debugLog = false;
+}
+
+/**
+ * @brief 推進目前世界一個 tick
+ * 呼叫端負責在每個 tick 之前寫入 gWorld->input 並切換每幀暫存配置器 (FrameArenaSwap)。
+ */
+void WorldStep()
+{
+    gTimer.Update();
+    // BrickUpdate(); // 更新磚塊狀態 (例如動畫)
+    EnemyUpdate();
+    PlayerUpdate(); // 更新玩家狀態 (讀取輸入)
+    BallUpdate(); // 更新球的狀態 (移動和碰撞)
+    MultiballUpdate(); // 額外的球，以及所有球之間的碰撞
+    ProjectileUpdate(); // 雷射 (PlayerUpdate 發射)
+    gTimer.Advance(); // 執行到期的計時器 (波次產生、爆炸結束)
+    // 偵測階段結束，各子系統批次處理本幀事件
+    PlayerHandleEvents();
+    BallHandleEvents();
+    MultiballHandleEvents(); // 在 BallHandleEvents 之後：依重設後的主球排列
+    ExplodHandleEvents();
+    EnemyHandleEvents(); // 最後處理：移除敵人會使擊中事件中的索引失效
+    EventClear();
+}
+
+// 目前的玩家輸入 (快照用)
+StateBlock InputStateBlock()
+{
+    return (StateBlock) { &gWorld->input, sizeof(GameInput) };
+}
+
+// 將玩家輸入累加進雜湊值
+uint64_t InputStateHash(uint64_t h)
+{
+    const GameInput* in = &gWorld->input;
+    uint8_t keys[3] = { in->left, in->right, in->fire };
+    return StateHashBytes(h, keys, sizeof(keys));
+}
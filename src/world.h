@@ -0,0 +1,52 @@
+#ifndef __WORLD_H__
+#define __WORLD_H__
+#include "autopilot.h"
+#include "ball.h"
+#include "brickout.h"
+#include "enemy.h"
+#include "event.h"
+#include "explod.h"
+#include "multiball.h"
+#include "player.h"
+#include "projectile.h"
+#include "raycast.h"
+#include "timer.h"
+#include "wave.h"
+#include <stdint.h>
+
+// 玩家輸入 (每 tick 由 GameUpdate 讀取鍵盤，或由批次執行器等外部控制器寫入)
+typedef struct GameInput {
+    bool left;
+    bool right;
+    bool fire; // 發射雷射 (需要雷射道具)
+} GameInput;
+
+// 一局遊戲的全部模擬狀態
+// 各子系統透過 gWorld 讀寫目前執行緒綁定的世界；貼圖、路徑表等唯讀資料由所有世界共用。
+typedef struct GameWorld {
+    Player player;
+    Ball ball;
+    Multiball multiball; // 多球模式的額外球 (欄位 0 為主球的複本)
+    Enemys enemys;
+    WaveState waves; // 敵人波次進度
+    Explod explods;
+    Projectiles projectiles; // 玩家板發射的雷射
+    Timer timer;
+    EventQueue events;
+    GameInput input;
+    Autopilot autopilot; // 啟用時由 PlayerUpdate 覆寫 input
+    RayGrid rays; // 射線查詢的格子 (由 RaycastBuild 建立，不屬於快照)
+    EnemySweep enemySweep; // 敵人分離的 x 軸順序 (跨 tick 保留，不屬於快照)
+    MultiballGrid ballGrid; // 球對球碰撞的格子 (每個 tick 由 MultiballUpdate 重建，不屬於快照)
+    bool debugLog; // DEBUG 模式下是否輸出模擬過程的訊息 (批次執行時關閉)
+} GameWorld;
+
+extern _Thread_local GameWorld* gWorld; // 目前執行緒操作的世界
+
+void WorldInit(GameWorld* world, uint32_t seed, float fixedStep); // 綁定並重設世界 (fixedStep 為 0 時使用實際時間)
+void WorldBind(GameWorld* world); // 將世界綁定到目前執行緒
+void WorldStep(); // 推進目前世界一個 tick (不讀取鍵盤、不繪圖)
+StateBlock InputStateBlock(); // 目前的玩家輸入 (快照用)
+uint64_t InputStateHash(uint64_t h); // 將玩家輸入累加進雜湊值
+
+#endif
@@ -0,0 +1,117 @@
+// 敵人路徑表產生器
+// 由 nob.c 在建置時編譯並執行：./build/pathgen src/pathtable.h
+// 輸出各路徑的座標點、線段單位切線與累積弧長 (R() 常數)，遊戲中不再於啟動時計算三角函數。
+// 新增路徑只需要在 paths[] 加上一組參數。
+#include <math.h>
+#include <stdio.h>
+
+#define PI 3.14159265358979323846
+
+// 路徑參數 (x = scaleX * cos(angle * PI / cosDiv) + offsetX，y 同理，每點 angle 減少 angleDec)
+typedef struct PathParam {
+    const char* name; // 說明 (輸出為註解)
+    int numPoints; // 點數量
+    double scaleX, scaleY; // 縮放比例
+    double offsetX, offsetY; // 中心
+    int initialAngle; // 角度初始值
+    int angleDec; // 每一步驟角度減少量
+    double cosDiv, sinDiv; // 角度除數 (決定 x/y 的頻率)
+} PathParam;
+
+static const PathParam paths[] = {
+    { "原始的繞行路徑", 72, 320.0, 150.0, 400.0, 180.0, 360 * 4, 20, 90.0, 360.0 },
+    { "左上角的小圓形軌道", 72, 100.0, 100.0, 200.0, 150.0, 0, 286, 180.0, 180.0 },
+    { "畫面中央上部的長條橢圓", 72, 300.0, 100.0, 400.0, 120.0, 0, 15, 180.0, 180.0 },
+    { "畫面右側的直立橢圓", 72, 100.0, 250.0, 650.0, 300.0, 360 * 2, 25, 180.0, 180.0 },
+    { "向下延伸的繞行路徑", 72, 250.0, 120.0, 400.0, 450.0, 0, 22, 120.0, 270.0 },
+};
+
+#define PATH_COUNT ((int)(sizeof(paths) / sizeof(paths[0])))
+
+typedef struct { double x, y; } Point;
+
+// 與原本的 CreatePathPoints 相同：角度先以整數取餘數再換算為圈數
+static void PathPoints(const PathParam* p, Point* out)
+{
+    int cosPeriod = (int)(2.0 * p->cosDiv);
+    int sinPeriod = (int)(2.0 * p->sinDiv);
+    int angle = p->initialAngle;
+    for (int i = 0; i < p->numPoints; i++) {
+        double cosTurns = (double)(angle % cosPeriod) / cosPeriod;
+        double sinTurns = (double)(angle % sinPeriod) / sinPeriod;
+        out[i].x = p->scaleX * cos(cosTurns * 2.0 * PI) + p->offsetX;
+        out[i].y = p->scaleY * sin(sinTurns * 2.0 * PI) + p->offsetY;
+        angle -= p->angleDec;
+    }
+}
+
+static void WriteTable(FILE* f)
+{
+    Point points[1024];
+    fprintf(f, "const EnemyPath enemyPath[PATH_COUNT] = {\n");
+    for (int k = 0; k < PATH_COUNT; k++) {
+        const PathParam* p = &paths[k];
+        int n = p->numPoints;
+        PathPoints(p, points);
+        fprintf(f, "    { // %d: %s\n", k, p->name);
+        fprintf(f, "        .points = {\n");
+        for (int i = 0; i < n; i++) {
+            fprintf(f, "            { R(%.4ff), R(%.4ff) },\n", points[i].x, points[i].y);
+        }
+        fprintf(f, "        },\n        .tangent = {\n");
+        for (int i = 0; i < n; i++) {
+            const Point* a = &points[i];
+            const Point* b = &points[(i + 1) % n];
+            double len = hypot(b->x - a->x, b->y - a->y);
+            double tx = len > 0.0 ? (b->x - a->x) / len : 0.0;
+            double ty = len > 0.0 ? (b->y - a->y) / len : 0.0;
+            fprintf(f, "            { R(%.6ff), R(%.6ff) },\n", tx, ty);
+        }
+        fprintf(f, "        },\n        .arcLength = {\n            R(0.0f),\n");
+        double s = 0.0;
+        for (int i = 0; i < n; i++) {
+            const Point* a = &points[i];
+            const Point* b = &points[(i + 1) % n];
+            s += hypot(b->x - a->x, b->y - a->y);
+            fprintf(f, "            R(%.4ff),\n", s);
+        }
+        fprintf(f, "        },\n        .pointCount = %d,\n    },\n", n);
+    }
+    fprintf(f, "};\n");
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2) {
+        fprintf(stderr, "usage: pathgen <output.h>\n");
+        return 1;
+    }
+    int maxPoints = 0;
+    for (int k = 0; k < PATH_COUNT; k++) {
+        if (paths[k].numPoints < 2 || paths[k].numPoints > 1024) {
+            fprintf(stderr, "pathgen: path %d has an invalid point count %d\n", k, paths[k].numPoints);
+            return 1;
+        }
+        if (paths[k].numPoints > maxPoints) {
+            maxPoints = paths[k].numPoints;
+        }
+    }
+    FILE* f = fopen(argv[1], "w");
+    if (f == NULL) {
+        fprintf(stderr, "pathgen: cannot open %s\n", argv[1]);
+        return 1;
+    }
+    fprintf(f, "// 由 tools/pathgen.c 產生 (nob.c 建置時自動更新)，請勿手動修改\n");
+    fprintf(f, "// 宣告部分由 enemy.h 引入；定義 PATHTABLE_IMPLEMENTATION 後引入則輸出路徑表 (只在 enemy.c)\n");
+    fprintf(f, "#ifndef __PATHTABLE_H__\n#define __PATHTABLE_H__\n\n");
+    fprintf(f, "#define PATH_COUNT %d // 路徑數量\n", PATH_COUNT);
+    fprintf(f, "#define PATH_MAX_POINTS %d // 最長路徑的點數\n\n", maxPoints);
+    fprintf(f, "#endif\n\n#ifdef PATHTABLE_IMPLEMENTATION\n");
+    WriteTable(f);
+    fprintf(f, "#endif\n");
+    if (fclose(f) != 0) {
+        fprintf(stderr, "pathgen: cannot write %s\n", argv[1]);
+        return 1;
+    }
+    return 0;
+}